@@ -18,6 +18,7 @@
  */
 
 #include "StringUtils.h"
+#include "DeterminizeAutomaton.h"
 #include "SimpleAutomaton.h"
 #include "SimpleAutomatonParser.h"
 
@@ -44,10 +45,12 @@ int main(int argc, const char* argv[]) {
     using namespace GetOpt;
 
     bool weak = false;
+    bool traces = false;
     String simulatorPath;
     String simulateePath;
     GetOpt_pp ops(argc, argv);
     ops >> OptionPresent('w', "weak", weak);
+    ops >> OptionPresent('t', "traces", traces);
     ops >> GlobalOption(simulatorPath);
     ops >> GlobalOption(simulateePath);
     
@@ -75,7 +78,14 @@ int main(int argc, const char* argv[]) {
         simulatee = parseAutomaton(simulateeStr);
     }
     
-    if (weak) {
+    if (traces) {
+        // for deterministic automata, simulation coincides with trace inclusion
+        DeterminizeAutomaton determinize(true);
+        if (determinize(*simulator)->simulates(*determinize(*simulatee)))
+            std::cout << "Observable traces of second automaton are included in those of first automaton" << std::endl;
+        else
+            std::cout << "Observable traces of second automaton are not included in those of first automaton" << std::endl;
+    } else if (weak) {
         if (simulator->weaklySimulates(*simulatee))
             std::cout << "First automaton weakly simulates second automaton" << std::endl;
         else
@@ -18,9 +18,12 @@
  */
 
 #include "StringUtils.h"
+#include "BitStateSearch.h"
+#include "CompressTimeChains.h"
 #include "ConstructBehavior.h"
 #include "ConstructMaximalNet.h"
 #include "LoadIntervalNet.h"
+#include "MinimizeAutomaton.h"
 #include "Behavior.h"
 #include "Behavior2Dot.h"
 #include "Automaton2Text.h"
@@ -28,6 +31,8 @@
 #include <getoptpp/getopt_pp.h>
 #include <cassert>
 #include <iostream>
+#include <new>
+#include <stdexcept>
 
 static void printUsage() {
     std::cout << "Usage:" << std::endl;
@@ -38,28 +43,70 @@ int main(int argc, const char* argv[]) {
     using namespace GetOpt;
     
     bool showBoundViolations = false;
+    bool reduce = false;
+    bool compressTime = false;
+    bool minimize = false;
+    bool bitState = false;
+    size_t log2BitCount = BitStateSearch::DefaultLog2BitCount;
     String format = "text";
     GetOpt_pp ops(argc, argv);
     ops >> OptionPresent('b', "showBoundViolations", showBoundViolations);
+    ops >> OptionPresent('r', "reduce", reduce);
+    // collapses chains of time steps into edges labelled "1^n" for a delay of n time steps
+    ops >> OptionPresent('c', "compressTime", compressTime);
+    ops >> OptionPresent('m', "minimize", minimize);
+    bitState = (ops >> Option('x', "bitState", log2BitCount));
     ops >> Option('f', "format", format);
     
     LoadIntervalNet loader;
     LoadIntervalNet::NetPtr net = loader(std::cin);
 
     ConstructMaximalNet maximal;
+    if (bitState) {
+        if (log2BitCount == 0 || log2BitCount > BitStateSearch::MaxLog2BitCount) {
+            std::cout << "Number of bits must be between 2^1 and 2^" << BitStateSearch::MaxLog2BitCount << std::endl;
+            exit(1);
+        }
+        
+        try {
+            BitStateSearch search(log2BitCount);
+            std::cout << search(maximal(net));
+        } catch (const std::bad_alloc&) {
+            std::cout << "Cannot allocate 2^" << log2BitCount << " bits" << std::endl;
+            exit(1);
+        } catch (const std::length_error&) {
+            std::cout << "Cannot allocate 2^" << log2BitCount << " bits" << std::endl;
+            exit(1);
+        }
+        return 0;
+    }
+    
     ConstructBehavior behavior;
     if (showBoundViolations)
         behavior.createBoundViolationState();
+    if (reduce)
+        behavior.usePartialOrderReduction();
+    
+    if (format != "text" && format != "dot") {
+        printUsage();
+        exit(1);
+    }
+    
+    Behavior::Ptr automaton = behavior(maximal(net));
+    if (minimize) {
+        MinimizeAutomaton minimizeAutomaton;
+        automaton = minimizeAutomaton(automaton);
+    }
+    if (compressTime) {
+        CompressTimeChains compress;
+        automaton = compress(automaton);
+    }
     
     if (format == "text") {
         Automaton2Text render;
-        Behavior::Ptr automaton = behavior(maximal(net));
         render(automaton.get(), std::cout);
-    } else if (format == "dot") {
-        Behavior2Dot render;
-        render(behavior(maximal(net)), std::cout);
     } else {
-        printUsage();
-        exit(1);
+        Behavior2Dot render;
+        render(automaton, std::cout);
     }
 }
@@ -22,8 +22,7 @@
 #include "ConstructRegionAutomaton.h"
 #include "LoadIntervalNet.h"
 #include "MarkUnsafeStates.h"
-#include "RemoveUnsafeStates.h"
-#include "RemoveUnreachableStates.h"
+#include "MinimizeAutomaton.h"
 #include "RenderClosureAutomaton.h"
 #include "Automaton2Text.h"
 
@@ -33,11 +32,27 @@
 #include <iostream>
 
 void printUsage();
+bool writeAutomaton(const Tippi::ClosureAutomaton::View& automaton, const String& format, bool showEmptyState, bool showSCCs, std::ostream& stream);
 
 void printUsage() {
     std::cout << "Usage:" << std::endl;
 }
 
+bool writeAutomaton(const Tippi::ClosureAutomaton::View& automaton, const String& format, const bool showEmptyState, const bool showSCCs, std::ostream& stream) {
+    using namespace Tippi;
+    
+    if (format == "text") {
+        Automaton2Text render;
+        render(&automaton, stream);
+    } else if (format == "dot") {
+        RenderClosureAutomaton render(stream, showEmptyState, showSCCs);
+        render(automaton);
+    } else {
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, const char* argv[]) {
     using namespace Tippi;
     using namespace GetOpt;
@@ -47,13 +62,17 @@ int main(int argc, const char* argv[]) {
     bool keepUnsafeStates = false;
     bool showEmptyState = false;
     bool showSCCs = false;
+    bool minimize = false;
+    String fullOutputPath;
     String format = "text";
     GetOpt_pp ops(argc, argv);
     useInputFile = (ops >> Option('i', "inputFile", filePath));
     ops >> OptionPresent('u', "keepUnsafeStates", keepUnsafeStates);
     ops >> OptionPresent('e', "showEmptyState", showEmptyState);
     ops >> OptionPresent('s', "showSCCs", showSCCs);
+    ops >> OptionPresent('m', "minimize", minimize);
     ops >> Option('f', "format", format);
+    ops >> Option('o', "fullOutputFile", fullOutputPath);
     
     LoadIntervalNet::NetPtr net;
     
@@ -78,24 +97,40 @@ int main(int argc, const char* argv[]) {
     MarkUnsafeStates markUnsafe;
     cl = markUnsafe(cl);
     
-    if (!keepUnsafeStates) {
-        RemoveUnsafeStates removeUnsafe;
-        cl = removeUnsafe(cl);
+    if (!fullOutputPath.empty()) {
+        std::ofstream fullStream(fullOutputPath.c_str());
+        if (!fullStream.is_open()) {
+            std::cout << "Cannot open file: " << fullOutputPath << std::endl;
+            exit(1);
+        }
+        
+        if (!writeAutomaton(ClosureAutomaton::View(*cl), format, showEmptyState, showSCCs, fullStream)) {
+            printUsage();
+            exit(1);
+        }
     }
     
-    RemoveUnreachableStates unreachable;
-    cl = unreachable(cl);
-     
-    if (format == "text") {
-        Automaton2Text render;
-        render(cl.get(), std::cout);
-    } else if (format == "dot") {
-        RenderClosureAutomaton render(std::cout, showEmptyState, showSCCs);
-        render(cl.get());
+    // the pruned automaton is a view, so the full automaton is not modified
+    ClosureAutomaton::View pruned(*cl);
+    if (!keepUnsafeStates)
+        pruned.hideIf(IsUnsafeState());
+    pruned.hideUnreachable();
+    
+    bool written;
+    if (minimize) {
+        // minimization modifies the automaton, so the hidden states must be deleted first
+        const ClosureAutomaton::View::StateList hidden = pruned.getHiddenStates();
+        cl->deleteStates(hidden.begin(), hidden.end());
+        
+        MinimizeAutomaton minimizeAutomaton;
+        cl = minimizeAutomaton(cl);
+        written = writeAutomaton(ClosureAutomaton::View(*cl), format, showEmptyState, showSCCs, std::cout);
     } else {
+        written = writeAutomaton(pruned, format, showEmptyState, showSCCs, std::cout);
+    }
+    
+    if (!written) {
         printUsage();
         exit(1);
     }
-    
 }
-
@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConstructClosureAutomaton.h"
+#include "ConstructMaximalNet.h"
+#include "ConstructRegionAutomaton.h"
+#include "LoadIntervalNet.h"
+#include "Automaton2Text.h"
+#include "Exceptions.h"
+
+#include <getoptpp/getopt_pp.h>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+
+void printUsage();
+
+void printUsage() {
+    std::cout << "Usage: net2reg [-i <file>] [-c] [-f text]" << std::endl;
+    std::cout << "  -i, --inputFile             read the net from the given file instead of stdin" << std::endl;
+    std::cout << "  -c, --fromClosureAutomaton  build the closure automaton first and compute its regions" << std::endl;
+    std::cout << "  -f, --format                the output format, only text is supported" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Without -c, the closures are identified by 64 bit fingerprints. Two different closures" << std::endl;
+    std::cout << "with the same fingerprint are detected if one of them is an entry closure of a region" << std::endl;
+    std::cout << "or both belong to the same region. Otherwise, their regions are merged, which is very" << std::endl;
+    std::cout << "unlikely, but cannot be ruled out. Use -c to compute the regions exactly." << std::endl;
+}
+
+int main(int argc, const char* argv[]) {
+    using namespace Tippi;
+    using namespace GetOpt;
+    
+    bool useInputFile = false;
+    String filePath;
+    bool fromClosureAutomaton = false;
+    String format = "text";
+    GetOpt_pp ops(argc, argv);
+    useInputFile = (ops >> Option('i', "inputFile", filePath));
+    ops >> OptionPresent('c', "fromClosureAutomaton", fromClosureAutomaton);
+    ops >> Option('f', "format", format);
+    
+    if (format != "text") {
+        printUsage();
+        exit(1);
+    }
+    
+    LoadIntervalNet::NetPtr net;
+    
+    if (useInputFile) {
+        std::ifstream fileStream(filePath.c_str());
+        if (!fileStream.is_open()) {
+            std::cout << "Cannot open file: " << filePath << std::endl;
+            exit(1);
+        }
+        
+        LoadIntervalNet loader;
+        net = loader(fileStream);
+    } else {
+        LoadIntervalNet loader;
+        net = loader(std::cin);
+    }
+    
+    ConstructMaximalNet maximal;
+    ConstructRegionAutomaton region;
+    ClosureAutomaton::Ptr cl;
+    RegionAutomaton::Ptr reg;
+    if (fromClosureAutomaton) {
+        // the regions refer to the closure states, so the closure automaton must be kept
+        ConstructClosureAutomaton closure;
+        cl = closure(maximal(net));
+        reg = region(cl);
+    } else {
+        // the regions are formed while the closures are explored, so the closure automaton is never built
+        try {
+            reg = region(maximal(net));
+        } catch (const ClosureException& e) {
+            std::cout << e.what() << std::endl;
+            exit(1);
+        }
+    }
+    
+    Automaton2Text render;
+    render(reg.get(), std::cout);
+}
@@ -20,16 +20,25 @@
 #ifndef __Tippi__Automaton__
 #define __Tippi__Automaton__
 
+#include "BitSet.h"
 #include "CollectionUtils.h"
 #include "Exceptions.h"
 #include "SharedPointer.h"
 #include "StringUtils.h"
 #include "GraphEdge.h"
+#include "ForwardBackwardComponents.h"
+#include "FrozenAutomaton.h"
 #include "GraphNode.h"
+#include "Label.h"
+#include "ObjectPool.h"
+#include "Simulation.h"
 
+#include <algorithm>
 #include <cassert>
 #include <list>
-#include <stack>
+#include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
 namespace Tippi {
@@ -44,7 +53,7 @@ namespace Tippi {
     template <class State>
     class AutomatonEdge : public GraphEdge<State, State> {
     protected:
-        String m_label;
+        Label m_label;
         bool m_observable;
     protected:
         /**
@@ -55,7 +64,7 @@ namespace Tippi {
          @param target the target state
          @param label the label
          */
-        AutomatonEdge(State* source, State* target, const String& label) :
+        AutomatonEdge(State* source, State* target, const Label& label) :
         GraphEdge<State, State>(source, target),
         m_label(label),
         m_observable(true) {
@@ -72,7 +81,7 @@ namespace Tippi {
          */
         AutomatonEdge(State* source, State* target) :
         GraphEdge<State, State>(source, target),
-        m_label(""),
+        m_label(),
         m_observable(false) {
             assert(source != NULL);
             assert(target != NULL);
@@ -83,7 +92,7 @@ namespace Tippi {
         /**
          Returns the label of this edge. If the edge is unobservable, the label will be empty.
          */
-        const String& getLabel() const {
+        const Label& getLabel() const {
             return m_label;
         }
         
@@ -99,6 +108,12 @@ namespace Tippi {
      A state of an automaton. Each state has an id, which must be set after it was created, and
      each state can either be final or nonfinal.
      
+     The label based queries such as findDirectSuccessor binary search an index of the edges of
+     the state that is sorted by label. The index is built by the first query and discarded when
+     an edge is added to or removed from the state, so states which are never queried by label do
+     not pay for it. Because a query may build the index, label queries on the same state must not
+     run concurrently.
+     
      This class template is supposed to be derived from. Implementers must provide two public types
      and one static public method <tt>getKey</tt>. The <tt>Key</tt> type is used to identify 
      particular states. 
@@ -124,9 +139,40 @@ namespace Tippi {
      */
     template <class Sub, class Edge>
     class AutomatonState : public GraphNode<Edge, Edge> {
+    public:
+        typedef GraphNode<Edge, Edge> Node;
+        typedef typename Node::IncomingList IncomingList;
+        typedef typename Node::OutgoingList OutgoingList;
+    private:
+        typedef std::pair<typename IncomingList::const_iterator, typename IncomingList::const_iterator> IncomingRange;
+        typedef std::pair<typename OutgoingList::const_iterator, typename OutgoingList::const_iterator> OutgoingRange;
+        
+        struct EdgeLabelLess {
+            bool operator() (const Edge* lhs, const Edge* rhs) const {
+                return lhs->getLabel() < rhs->getLabel();
+            }
+            
+            bool operator() (const Edge* lhs, const Label& rhs) const {
+                return lhs->getLabel() < rhs;
+            }
+            
+            bool operator() (const Label& lhs, const Edge* rhs) const {
+                return lhs < rhs->getLabel();
+            }
+        };
+        
+        /**
+         The incoming and outgoing edges of a state, sorted by label.
+         */
+        struct SortedEdges {
+            IncomingList incoming;
+            OutgoingList outgoing;
+        };
     protected:
         size_t m_id;
         bool m_final;
+    private:
+        mutable std::unique_ptr<SortedEdges> m_labelIndex;
     protected:
         /**
          Creates a new, nonfinal state.
@@ -171,12 +217,44 @@ namespace Tippi {
             m_final = final;
         }
         
+        void addIncoming(Edge* edge) {
+            m_labelIndex.reset();
+            Node::addIncoming(edge);
+        }
+        
+        void removeIncoming(Edge* edge) {
+            m_labelIndex.reset();
+            Node::removeIncoming(edge);
+        }
+        
+        template <typename P>
+        void removeIncomingIf(const P& predicate) {
+            m_labelIndex.reset();
+            Node::removeIncomingIf(predicate);
+        }
+        
+        void addOutgoing(Edge* edge) {
+            m_labelIndex.reset();
+            Node::addOutgoing(edge);
+        }
+        
+        void removeOutgoing(Edge* edge) {
+            m_labelIndex.reset();
+            Node::removeOutgoing(edge);
+        }
+        
+        template <typename P>
+        void removeOutgoingIf(const P& predicate) {
+            m_labelIndex.reset();
+            Node::removeOutgoingIf(predicate);
+        }
+        
         /**
          Indicates whether this state has an observable incoming edge with the given label.
          
          @param label the label of the incoming edge
          */
-        bool hasIncomingEdge(const String& label) const {
+        bool hasIncomingEdge(const Label& label) const {
             return findDirectPredecessor(label) != NULL;
         }
         
@@ -185,7 +263,7 @@ namespace Tippi {
          
          @param label the laben of the outgoing edge
          */
-        bool hasOutgoingEdge(const String& label) const {
+        bool hasOutgoingEdge(const Label& label) const {
             return findDirectSuccessor(label) != NULL;
         }
         
@@ -196,14 +274,13 @@ namespace Tippi {
          @param label the label of the incoming edges
          @return a possibly empty vector of states
          */
-        const std::vector<typename Edge::Source*> getDirectPredecessors(const String& label) const {
+        const std::vector<typename Edge::Source*> getDirectPredecessors(const Label& label) const {
             std::vector<typename Edge::Target*> result;
-            const typename GraphNode<Edge, Edge>::IncomingList& edges = GraphNode<Edge, Edge>::getIncoming();
-            typename GraphNode<Edge, Edge>::IncomingList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+            const IncomingRange edges = findIncoming(label);
+            typename IncomingList::const_iterator it;
+            for (it = edges.first; it != edges.second; ++it) {
                 Edge* edge = *it;
-                if (edge->getLabel() == label)
-                    result.push_back(edge->getSource());
+                result.push_back(edge->getSource());
             }
             return result;
         }
@@ -216,13 +293,12 @@ namespace Tippi {
          @param label the label of the incoming edge
          @return a state or NULL
          */
-        const typename Edge::Source* findDirectPredecessor(const String& label) const {
-            const typename GraphNode<Edge, Edge>::IncomingList& edges = GraphNode<Edge, Edge>::getIncoming();
-            typename GraphNode<Edge, Edge>::IncomingList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+        const typename Edge::Source* findDirectPredecessor(const Label& label) const {
+            const IncomingRange edges = findIncoming(label);
+            typename IncomingList::const_iterator it;
+            for (it = edges.first; it != edges.second; ++it) {
                 const Edge* edge = *it;
-                if (edge->getLabel() == label)
-                    return edge->getSource();
+                return edge->getSource();
             }
             return NULL;
         }
@@ -234,14 +310,13 @@ namespace Tippi {
          @param label the label of the outgoing edges
          @return a possibly empty vector of states
          */
-        const std::vector<typename Edge::Target*> getDirectSuccessors(const String& label) const {
+        const std::vector<typename Edge::Target*> getDirectSuccessors(const Label& label) const {
             std::vector<typename Edge::Target*> result;
-            const typename GraphNode<Edge, Edge>::OutgoingList& edges = GraphNode<Edge, Edge>::getOutgoing();
-            typename GraphNode<Edge, Edge>::OutgoingList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+            const OutgoingRange edges = findOutgoing(label);
+            typename OutgoingList::const_iterator it;
+            for (it = edges.first; it != edges.second; ++it) {
                 Edge* edge = *it;
-                if (edge->getLabel() == label)
-                    result.push_back(edge->getTarget());
+                result.push_back(edge->getTarget());
             }
             return result;
         }
@@ -254,201 +329,228 @@ namespace Tippi {
          @param label the label of the outgoing edge
          @return a state or NULL
          */
-        const typename Edge::Target* findDirectSuccessor(const String& label) const {
-            const typename GraphNode<Edge, Edge>::OutgoingList& edges = GraphNode<Edge, Edge>::getOutgoing();
-            typename GraphNode<Edge, Edge>::OutgoingList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+        const typename Edge::Target* findDirectSuccessor(const Label& label) const {
+            const OutgoingRange edges = findOutgoing(label);
+            typename OutgoingList::const_iterator it;
+            for (it = edges.first; it != edges.second; ++it) {
                 const Edge* edge = *it;
-                if (edge->getLabel() == label)
-                    return edge->getTarget();
+                return edge->getTarget();
             }
             return NULL;
         }
-        
+    private:
         /**
-         Returns a vector of all states reachable from this state with only unobservable edges 
-         followed by one edge with the given label.
-         
-         @param label the label of the last edge
-         @return a possibly empty vector of states
+         Returns the range of incoming edges with the given label.
          */
-        const std::vector<typename Edge::Target*> getIndirectSuccessors(const String& label) const {
-            std::vector<typename Edge::Target*> result;
-            getIndirectSuccessors(label, result);
-            return result;
+        IncomingRange findIncoming(const Label& label) const {
+            const SortedEdges& index = getLabelIndex();
+            return std::equal_range(index.incoming.begin(), index.incoming.end(), label, EdgeLabelLess());
         }
-
+        
         /**
-         Returns a state which is reachable from this state with only unobservable edges followed
-         by one edge with the given label. If no such state exists, this method returns NULL. If
-         more than one such states exist, this method returns one of these states.
-         
-         @param label the label of the last edge
-         @return a state or NULL
+         Returns the range of outgoing edges with the given label.
          */
-        const typename Edge::Target* findIndirectSuccessor(const String& label) const {
-            const typename GraphNode<Edge, Edge>::OutgoingList& edges = GraphNode<Edge, Edge>::getOutgoing();
-            typename GraphNode<Edge, Edge>::OutgoingList::const_iterator it, end;
-            
-            // first look for direct successors
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
-                const Edge* edge = *it;
-                if (edge->isObservable() && edge->getLabel() == label)
-                    return edge->getTarget();
-            }
-            
-            // now recursively look for indirect successors
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
-                const Edge* edge = *it;
-                if (!edge->isObservable()) {
-                    const typename Edge::Target* target = edge->getTarget();
-                    const typename Edge::Target* successor = target->findIndirectSuccessor(label);
-                    if (successor != NULL)
-                        return successor;
-                }
-            }
-            return NULL;
+        OutgoingRange findOutgoing(const Label& label) const {
+            const SortedEdges& index = getLabelIndex();
+            return std::equal_range(index.outgoing.begin(), index.outgoing.end(), label, EdgeLabelLess());
         }
-    private:
-        void getIndirectSuccessors(const String& label, std::vector<typename Edge::Target*>& result) {
-            const typename GraphNode<Edge, Edge>::OutgoingList& edges = GraphNode<Edge, Edge>::getOutgoing();
-            typename GraphNode<Edge, Edge>::OutgoingList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
-                const Edge* edge = *it;
-                const typename Edge::Target* successor = edge->getTarget();
-                if (edge->isTau())
-                    successor->getIndirectSuccessors(label, result);
-                else if (edge->getLabel() == label)
-                    result.push_back(successor);
+        
+        const SortedEdges& getLabelIndex() const {
+            if (m_labelIndex == NULL) {
+                m_labelIndex.reset(new SortedEdges());
+                m_labelIndex->incoming = Node::getIncoming();
+                m_labelIndex->outgoing = Node::getOutgoing();
+                std::stable_sort(m_labelIndex->incoming.begin(), m_labelIndex->incoming.end(), EdgeLabelLess());
+                std::stable_sort(m_labelIndex->outgoing.begin(), m_labelIndex->outgoing.end(), EdgeLabelLess());
             }
+            return *m_labelIndex;
         }
     };
     
+    /**
+     The strongly connected components of an automaton. The states of all components are stored in
+     a single array in which the states of each component occupy a contiguous range, sorted by
+     their ids.
+     */
     template <class StateT>
-    class Component {
+    class Components {
     public:
-        typedef std::list<Component> List;
-        typedef std::set<StateT*> StateSet;
+        typedef std::vector<StateT*> StateList;
+        typedef typename StateList::const_iterator StateIterator;
+        typedef std::pair<StateIterator, StateIterator> StateRange;
+        
+        static const size_t None = static_cast<size_t>(-1);
     private:
-        StateSet m_states;
+        struct IdLess {
+            bool operator()(const StateT* lhs, const StateT* rhs) const {
+                return lhs->getId() < rhs->getId();
+            }
+        };
+        
+        StateList m_states;
+        std::vector<size_t> m_offsets;
+        std::vector<size_t> m_componentOf;
     public:
-        const StateSet& getStates() const {
-            return m_states;
+        /**
+         Creates an empty set of components.
+         
+         @param stateCount the number of state ids, i.e., the maximal id plus one
+         */
+        Components(const size_t stateCount) :
+        m_offsets(1, 0),
+        m_componentOf(stateCount, None) {}
+        
+        size_t size() const {
+            return m_offsets.size() - 1;
         }
         
-        void addState(StateT* state) {
-            m_states.insert(state);
+        bool empty() const {
+            return size() == 0;
         }
         
-        bool containsFinalState() const {
-            typename StateSet::const_iterator sIt, sEnd;
-            for (sIt = m_states.begin(), sEnd = m_states.end(); sIt != sEnd; ++sIt) {
-                const StateT* state = *sIt;
-                if (state->isFinal())
-                    return true;
-            }
-            return false;
+        StateRange getStates(const size_t component) const {
+            assert(component < size());
+            return StateRange(m_states.begin() + static_cast<long>(m_offsets[component]),
+                              m_states.begin() + static_cast<long>(m_offsets[component + 1]));
         }
         
-        bool hasExit() const {
-            typename StateSet::const_iterator sIt, sEnd;
-            for (sIt = m_states.begin(), sEnd = m_states.end(); sIt != sEnd; ++sIt) {
-                const StateT* state = *sIt;
-                typename StateT::Outgoing::List& outgoing = state->getOutgoing();
-                typename StateT::Outgoing::List::const_iterator eIt, eEnd;
-                for (eIt = outgoing.begin(), eEnd = outgoing.end(); eIt != eEnd; ++eIt) {
-                    const typename StateT::Outgoing* edge = *eIt;
-                    const StateT* target = edge->getTarget();
-                    if (m_states.count(target) > 0)
-                        return true;
-                }
-            }
-            
-            return false;
+        size_t getStateCount(const size_t component) const {
+            assert(component < size());
+            return m_offsets[component + 1] - m_offsets[component];
+        }
+        
+        /**
+         Returns the index of the component of the given state or None if the state does not belong
+         to any component.
+         */
+        size_t getComponent(const StateT* state) const {
+            const size_t id = state->getId();
+            return id < m_componentOf.size() ? m_componentOf[id] : None;
+        }
+        
+        bool contains(const size_t component, const StateT* state) const {
+            return getComponent(state) == component;
+        }
+        
+        /**
+         Adds a state to the component which is currently being built.
+         */
+        void addState(StateT* state) {
+            assert(getComponent(state) == None);
+            m_componentOf[state->getId()] = size();
+            m_states.push_back(state);
+        }
+        
+        /**
+         Completes the component which is currently being built.
+         */
+        void closeComponent() {
+            assert(m_states.size() > m_offsets.back());
+            std::sort(m_states.begin() + static_cast<long>(m_offsets.back()), m_states.end(), IdLess());
+            m_offsets.push_back(m_states.size());
         }
     };
     
+    template <class StateT>
+    const size_t Components<StateT>::None;
+    
+    /**
+     Computes the strongly connected components of the states that are reachable from a given
+     state using an iterative version of Tarjan's algorithm. The bookkeeping is stored in arrays
+     that are indexed by the state ids, and the recursion is replaced by an explicit stack of
+     frames, so the depth of the automaton is not limited by the call stack.
+     
+     The components are found in reverse topological order, that is, every component is found
+     after all components that are reachable from it.
+     */
     template <class StateT>
     class ComputeComponents {
-    private:
-        typedef Component<StateT> ComponentT;
     public:
-        typedef typename ComponentT::List ComponentList;
+        typedef Components<StateT> ComponentsT;
     private:
-        typedef size_t Index;
+        typedef typename StateT::Outgoing Edge;
+        typedef typename StateT::OutgoingList EdgeList;
         
-        struct StateInfo {
-            Index index;
-            Index lowLink;
-            bool onStack;
-            
-            StateInfo() : index(0), lowLink(0), onStack(false) {}
-            StateInfo(const Index i_index) : index(i_index), lowLink(i_index), onStack(true) {}
+        struct Frame {
+            StateT* state;
+            size_t edge;
             
-            bool isRootNode() const {
-                return lowLink == index;
-            }
-            
-            void updateLowLink(const Index i_index) {
-                lowLink = std::min(lowLink, i_index);
-            }
+            Frame(StateT* i_state) : state(i_state), edge(0) {}
         };
         
-        typedef std::map<StateT*, StateInfo> InfoMap;
-        InfoMap m_infos;
-        
-        typedef std::stack<StateT*> StateStack;
-        StateStack m_stack;
-        
-        Index m_index;
-        ComponentList m_components;
+        std::vector<size_t> m_index;
+        std::vector<size_t> m_lowLink;
+        std::vector<StateT*> m_stack;
+        std::vector<Frame> m_frames;
+        size_t m_nextIndex;
+        const BitSet* m_visible;
+        ComponentsT m_components;
     public:
-        ComputeComponents(StateT* initialState) :
-        m_index(0) {
-            visitState(initialState);
+        /**
+         Computes the components.
+         
+         @param initialState the state to start from
+         @param stateCount the number of state ids, i.e., the maximal id plus one
+         @param visible if not NULL, the ids of the states to consider, all other states and their
+         edges are ignored
+         */
+        ComputeComponents(StateT* initialState, const size_t stateCount, const BitSet* visible = NULL) :
+        m_index(stateCount, 0),
+        m_lowLink(stateCount, 0),
+        m_nextIndex(1),
+        m_visible(visible),
+        m_components(stateCount) {
+            if (initialState != NULL)
+                compute(initialState);
         }
-
-        const ComponentList& getComponents() const {
+        
+        const ComponentsT& getComponents() const {
             return m_components;
         }
     private:
-        StateInfo& visitState(StateT* state) {
-            assert(m_infos.count(state) == 0);
-            
-            typename InfoMap::iterator sIt = m_infos.insert(std::make_pair(state, StateInfo(m_index++))).first;
-            StateInfo& stateInfo = sIt->second;
-            m_stack.push(state);
-            
-            typedef typename StateT::Outgoing::List OutList;
-            const OutList& edges = state->getOutgoing();
-            typename OutList::const_iterator eIt, eEnd;
-            for (eIt = edges.begin(), eEnd = edges.end(); eIt != eEnd; ++eIt) {
-                typename StateT::Outgoing* edge = *eIt;
+        void compute(StateT* initialState) {
+            push(initialState);
+            while (!m_frames.empty()) {
+                Frame& frame = m_frames.back();
+                StateT* state = frame.state;
+                const size_t id = state->getId();
+                const EdgeList& edges = state->getOutgoing();
                 
-                typename InfoMap::iterator iIt = m_infos.find(edge->getTarget());
-                if (iIt == m_infos.end()) {
-                    const StateInfo& targetInfo = visitState(edge->getTarget());
-                    stateInfo.updateLowLink(targetInfo.lowLink);
+                if (frame.edge < edges.size()) {
+                    StateT* target = edges[frame.edge++]->getTarget();
+                    const size_t targetId = target->getId();
+                    if (m_visible != NULL && !m_visible->test(targetId))
+                        continue;
+                    if (m_index[targetId] == 0)
+                        push(target); // invalidates frame
+                    else if (m_components.getComponent(target) == ComponentsT::None)
+                        m_lowLink[id] = std::min(m_lowLink[id], m_index[targetId]);
                 } else {
-                    const StateInfo& targetInfo = iIt->second;
-                    if (targetInfo.onStack)
-                        stateInfo.updateLowLink(targetInfo.index);
+                    m_frames.pop_back();
+                    if (!m_frames.empty()) {
+                        const size_t parentId = m_frames.back().state->getId();
+                        m_lowLink[parentId] = std::min(m_lowLink[parentId], m_lowLink[id]);
+                    }
+                    
+                    if (m_lowLink[id] == m_index[id]) {
+                        StateT* top;
+                        do {
+                            top = m_stack.back();
+                            m_stack.pop_back();
+                            m_components.addState(top);
+                        } while (top != state);
+                        m_components.closeComponent();
+                    }
                 }
             }
-            
-            if (stateInfo.isRootNode()) {
-                ComponentT component;
-                StateT* top;
-                do {
-                    top = m_stack.top(); m_stack.pop();
-                    m_infos[top].onStack = false;
-                    component.addState(top);
-                } while (top != state);
-                
-                m_components.push_back(component);
-            }
-            
-            return stateInfo;
+        }
+        
+        void push(StateT* state) {
+            const size_t id = state->getId();
+            assert(id < m_index.size());
+            m_index[id] = m_lowLink[id] = m_nextIndex++;
+            m_stack.push_back(state);
+            m_frames.push_back(Frame(state));
         }
     };
     
@@ -464,11 +566,23 @@ namespace Tippi {
     template <class StateT, class EdgeT>
     class Automaton {
     private:
+        struct IsIncidentEdge {
+            const BitSet& states;
+            
+            IsIncidentEdge(const BitSet& i_states) : states(i_states) {}
+            
+            bool operator()(const EdgeT* edge) const {
+                return states.test(edge->getSource()->getId()) || states.test(edge->getTarget()->getId());
+            }
+        };
+        
         /**
          Implements a weak total order for states by virtue of the StateT::Key type,
          the StateT::KeyCmp type and the static StateT::getKey method.
          */
         struct StateLess {
+            typedef void is_transparent;
+            
             typename StateT::KeyCmp m_cmp;
             
             bool operator() (const StateT* lhs, const StateT* rhs) const {
@@ -492,12 +606,35 @@ namespace Tippi {
                 return m_cmp(lhs, rhs) < 0;
             }
         };
+        /**
+         Orders edges by the ids of their source and target states and by their label indices. This
+         order is cheap to evaluate and is used to find duplicate edges, but it depends on the order
+         in which the states were created and the labels were interned.
+         */
+        struct EdgeLess {
+            bool operator() (const EdgeT* lhs, const EdgeT* rhs) const {
+                assert(lhs != NULL);
+                assert(rhs != NULL);
+                
+                const size_t lhsSource = lhs->getSource()->getId();
+                const size_t rhsSource = rhs->getSource()->getId();
+                if (lhsSource != rhsSource)
+                    return lhsSource < rhsSource;
+                
+                const size_t lhsTarget = lhs->getTarget()->getId();
+                const size_t rhsTarget = rhs->getTarget()->getId();
+                if (lhsTarget != rhsTarget)
+                    return lhsTarget < rhsTarget;
+                return lhs->getLabel() < rhs->getLabel();
+            }
+        };
+        
         /**
          Implements a weak total order for edges by virtue of the StateT::Key type,
          the StateT::KeyCmp type and the static StateT::getKey method. If the source and target
          states of two edges are considered equal, the label is used as the order criterion.
          */
-        struct EdgeLess {
+        struct EdgeKeyLess {
             typename StateT::KeyCmp m_stateCmp;
             
             bool operator() (const EdgeT* lhs, const EdgeT* rhs) const {
@@ -521,13 +658,16 @@ namespace Tippi {
     public:
         typedef StateT State;
         typedef EdgeT Edge;
-        typedef Component<State> Component;
-        typedef typename Component::List ComponentList;
+        typedef Tippi::Components<State> Components;
         
         typedef std::list<StateT*> StateList;
         typedef std::set<StateT*, StateLess> StateSet;
         typedef std::set<EdgeT*, EdgeLess> EdgeSet;
+        typedef std::vector<EdgeT*> EdgeList;
     private:
+        ObjectPool<StateT> m_statePool;
+        ObjectPool<EdgeT> m_edgePool;
+        
         StateSet m_states;
         EdgeSet m_edges;
         StateT* m_initialState;
@@ -543,8 +683,10 @@ namespace Tippi {
         m_nextId(1) {}
     public:
         virtual ~Automaton() {
-            CollectionUtils::clearAndDelete(m_states);
-            CollectionUtils::clearAndDelete(m_edges);
+            destroyStates(m_states.begin(), m_states.end());
+            destroyEdges(m_edges.begin(), m_edges.end());
+            m_states.clear();
+            m_edges.clear();
             m_initialState = NULL;
             m_finalStates.clear();
         }
@@ -556,56 +698,50 @@ namespace Tippi {
             return m_nextId - 1;
         }
         
-        template <typename A1>
-        StateT* findState(const A1& a1) const {
-            State state(a1);
-            return findState(state);
-        }
-        
-        template <typename A1, typename A2>
-        StateT* findState(const A1& a1, const A2& a2) const {
-            State state(a1, a2);
-            return findState(state);
-        }
-        
-        template <typename A1, typename A2, typename A3>
-        StateT* findState(const A1& a1, const A2& a2, const A3& a3) const {
-            State state(a1, a2, a3);
-            return findState(state);
-        }
-
-        StateT* createState() {
-            return addState(new State());
-        }
-        
-        template <typename A1>
-        StateT* createState(const A1& a1) {
-            return addState(new State(a1));
-        }
-        
-        template <typename A1, typename A2>
-        StateT* createState(const A1& a1, const A2& a2) {
-            return addState(new State(a1, a2));
-        }
-        
-        template <typename A1, typename A2, typename A3>
-        StateT* createState(const A1& a1, const A2& a2, const A3& a3) {
-            return addState(new State(a1, a3));
-        }
-        
-        template <typename A1>
-        std::pair<StateT*, bool> findOrCreateState(const A1& a1) {
-            return findOrAddState(new State(a1));
+        /**
+         Returns the state with the given key or NULL if this automaton does not contain such a
+         state. No state is constructed to perform the lookup.
+         */
+        StateT* findState(const typename StateT::Key& key) const {
+            typename StateSet::const_iterator it = m_states.find(key);
+            if (it == m_states.end())
+                return NULL;
+            return *it;
         }
         
-        template <typename A1, typename A2>
-        std::pair<StateT*, bool> findOrCreateState(const A1& a1, const A2& a2) {
-            return findOrAddState(new State(a1, a2));
+        /**
+         Creates a new state by forwarding the given arguments to its constructor.
+         
+         @throws AutomatonException if the automaton already contains an equal state
+         */
+        template <typename... Args>
+        StateT* createState(Args&&... args) {
+            return addState(new (m_statePool.allocate()) State(std::forward<Args>(args)...));
         }
         
-        template <typename A1, typename A2, typename A3>
-        std::pair<StateT*, bool> findOrCreateState(const A1& a1, const A2& a2, const A3& a3) {
-            return findOrAddState(new State(a1, a3));
+        /**
+         Returns the state with the given key and creates it if this automaton does not contain
+         such a state yet. The new state is constructed from the given key, which is moved into
+         the state if it is an rvalue. If the state already exists, nothing is constructed.
+         
+         @param key the key of the state
+         @return the state and whether it was created
+         */
+        template <typename K>
+        std::pair<StateT*, bool> findOrCreateState(K&& key) {
+            typename StateSet::iterator it;
+            {
+                const typename StateT::Key& probe = key;
+                it = m_states.lower_bound(probe);
+                if (it != m_states.end() && !m_states.key_comp()(probe, *it))
+                    return std::make_pair(*it, false);
+            }
+            
+            StateT* state = new (m_statePool.allocate()) State(std::forward<K>(key));
+            m_states.insert(it, state);
+            setStateId(state);
+            stateWasAdded(state);
+            return std::make_pair(state, true);
         }
         
         void deleteState(StateT* state) {
@@ -620,53 +756,125 @@ namespace Tippi {
             if (m_initialState == state)
                 m_initialState = NULL;
             SetUtils::remove(m_finalStates, state);
-            delete state;
+            m_statePool.destroy(state);
         }
         
+        /**
+         Deletes the given states and all of their edges. The states are marked first, then the
+         edges and the state sets are swept once, and the edge lists of the remaining neighbours
+         are compacted in place, so the cost is linear in the size of the automaton instead of
+         depending on the number of deleted states.
+         */
         template <typename I>
         void deleteStates(I cur, I end) {
+            BitSet deleted(getMaxId() + 1);
+            std::vector<StateT*> states;
             while (cur != end) {
-                deleteState(*cur);
+                StateT* state = *cur;
+                assert(state != NULL);
+                assert(m_states.count(state) == 1);
+                if (deleted.testAndSet(state->getId()))
+                    states.push_back(state);
                 ++cur;
             }
+            
+            if (states.empty())
+                return;
+            
+            const IsIncidentEdge incident(deleted);
+            BitSet touched(deleted.size());
+            std::vector<StateT*> neighbours;
+            std::vector<EdgeT*> edges;
+            
+            EdgeSet remainingEdges;
+            typename EdgeSet::const_iterator eIt, eEnd;
+            for (eIt = m_edges.begin(), eEnd = m_edges.end(); eIt != eEnd; ++eIt) {
+                EdgeT* edge = *eIt;
+                if (incident(edge)) {
+                    edges.push_back(edge);
+                    
+                    StateT* source = edge->getSource();
+                    StateT* target = edge->getTarget();
+                    if (!deleted.test(source->getId()) && touched.testAndSet(source->getId()))
+                        neighbours.push_back(source);
+                    if (!deleted.test(target->getId()) && touched.testAndSet(target->getId()))
+                        neighbours.push_back(target);
+                } else {
+                    remainingEdges.insert(remainingEdges.end(), edge);
+                }
+            }
+            m_edges.swap(remainingEdges);
+            
+            typename std::vector<StateT*>::const_iterator sIt, sEnd;
+            for (sIt = neighbours.begin(), sEnd = neighbours.end(); sIt != sEnd; ++sIt) {
+                StateT* neighbour = *sIt;
+                neighbour->removeIncomingIf(incident);
+                neighbour->removeOutgoingIf(incident);
+            }
+            
+            removeStates(m_states, deleted);
+            removeStates(m_finalStates, deleted);
+            if (m_initialState != NULL && deleted.test(m_initialState->getId()))
+                m_initialState = NULL;
+            
+            destroyEdges(edges.begin(), edges.end());
+            destroyStates(states.begin(), states.end());
         }
         
-        EdgeT* connectWithObservableEdge(StateT* source, StateT* target, const String& label) {
-            return connect(new EdgeT(source, target, label));
-        }
-        
-        template <typename A1>
-        EdgeT* connectWithObservableEdge(StateT* source, StateT* target, const String& label, const A1& a1) {
-            return connect(new EdgeT(source, target, label, a1));
-        }
-        
-        template <typename A1, typename A2>
-        EdgeT* connectWithObservableEdge(StateT* source, StateT* target, const String& label, const A1& a1, const A2& a2) {
-            return connect(new EdgeT(source, target, label, a1, a2));
-        }
-        
-        template <typename A1, typename A2, typename A3>
-        EdgeT* connectWithObservableEdge(StateT* source, StateT* target, const String& label, const A1& a1, const A2& a2, const A3& a3) {
-            return connect(new EdgeT(source, target, label, a1, a2, a3));
-        }
-        
-        EdgeT* connectWithUnobservableEdge(StateT* source, StateT* target) {
-            return connect(new EdgeT(source, target));
-        }
-        
-        template <typename A1>
-        EdgeT* connectWithUnobservableEdge(StateT* source, StateT* target, const A1& a1) {
-            return connect(new EdgeT(source, target, a1));
+        /**
+         Merges the given state into the given target state. All edges of the state are redirected
+         to the target state, and edges which then duplicate an edge of the target state are
+         deleted. Afterwards, the state is deleted.
+         
+         @param target the state that remains
+         @param state the state to merge into the target state
+         */
+        void mergeStates(StateT* target, StateT* state) {
+            assert(target != NULL);
+            assert(state != NULL);
+            assert(target != state);
+            assert(m_states.count(target) == 1);
+            assert(m_states.count(state) == 1);
+            
+            // the edges must be removed from the edge set before their keys change
+            std::vector<EdgeT*> edges(state->getOutgoing().begin(), state->getOutgoing().end());
+            const typename StateT::IncomingList& incoming = state->getIncoming();
+            typename StateT::IncomingList::const_iterator it, end;
+            for (it = incoming.begin(), end = incoming.end(); it != end; ++it) {
+                EdgeT* edge = *it;
+                if (!edge->isLoop())
+                    edges.push_back(edge);
+            }
+            SetUtils::remove(m_edges, edges.begin(), edges.end());
+            
+            state->replaceAsSource(target);
+            state->replaceAsTarget(target);
+            
+            typename std::vector<EdgeT*>::const_iterator eIt, eEnd;
+            for (eIt = edges.begin(), eEnd = edges.end(); eIt != eEnd; ++eIt) {
+                EdgeT* edge = *eIt;
+                if (!m_edges.insert(edge).second) {
+                    edge->removeFromSource();
+                    edge->removeFromTarget();
+                    m_edgePool.destroy(edge);
+                }
+            }
+            
+            SetUtils::remove(m_states, state);
+            if (m_initialState == state)
+                m_initialState = target;
+            SetUtils::remove(m_finalStates, state);
+            m_statePool.destroy(state);
         }
         
-        template <typename A1, typename A2>
-        EdgeT* connectWithUnobservableEdge(StateT* source, StateT* target, const A1& a1, const A2& a2) {
-            return connect(new EdgeT(source, target, a1, a2));
+        template <typename... Args>
+        EdgeT* connectWithObservableEdge(StateT* source, StateT* target, const Label& label, Args&&... args) {
+            return connect(new (m_edgePool.allocate()) EdgeT(source, target, label, std::forward<Args>(args)...));
         }
         
-        template <typename A1, typename A2, typename A3>
-        EdgeT* connectWithUnobservableEdge(StateT* source, StateT* target, const A1& a1, const A2& a2, const A3& a3) {
-            return connect(new EdgeT(source, target, a1, a2, a3));
+        template <typename... Args>
+        EdgeT* connectWithUnobservableEdge(StateT* source, StateT* target, Args&&... args) {
+            return connect(new (m_edgePool.allocate()) EdgeT(source, target, std::forward<Args>(args)...));
         }
 
         void disconnect(EdgeT* edge) {
@@ -678,7 +886,7 @@ namespace Tippi {
             edge->removeFromSource();
             edge->removeFromTarget();
             m_edges.erase(it);
-            delete edge;
+            m_edgePool.destroy(edge);
         }
 
         void setInitialState(StateT* state) {
@@ -698,6 +906,17 @@ namespace Tippi {
         const EdgeSet& getEdges() const {
             return m_edges;
         }
+        
+        /**
+         Returns the edges ordered by the keys of their source and target states and by their
+         labels. Unlike the order of getEdges, this order does not depend on the order in which the
+         states were created, so it should be used for output.
+         */
+        EdgeList getSortedEdges() const {
+            EdgeList result(m_edges.begin(), m_edges.end());
+            std::sort(result.begin(), result.end(), EdgeKeyLess());
+            return result;
+        }
 
         StateT* getInitialState() const {
             return m_initialState;
@@ -707,27 +926,93 @@ namespace Tippi {
             return m_finalStates;
         }
         
-        ComponentList computeComponents() const {
-            ComputeComponents<State> compute(getInitialState());
+        /**
+         Returns a compact snapshot of the current structure of this automaton for read only
+         passes. The snapshot must not be used after states or edges are added or removed.
+         */
+        FrozenAutomaton<StateT, EdgeT> freeze() const {
+            return FrozenAutomaton<StateT, EdgeT>(m_initialState, m_states, getMaxId());
+        }
+        
+        Components computeComponents() const {
+            ComputeComponents<State> compute(m_initialState, getMaxId() + 1);
+            return compute.getComponents();
+        }
+        
+        /**
+         Computes the strongly connected components of the subautomaton that consists of the states
+         whose ids are set in the given bit set. The initial state must be one of these states.
+         */
+        Components computeComponents(const BitSet& visible) const {
+            assert(m_initialState == NULL || visible.test(m_initialState->getId()));
+            ComputeComponents<State> compute(m_initialState, getMaxId() + 1, &visible);
             return compute.getComponents();
         }
         
+        /**
+         Computes the strongly connected components of the states that are reachable from the
+         initial state using the forward-backward algorithm, which processes independent parts of
+         the automaton in parallel if OpenMP is available. Unlike computeComponents, the components
+         are not returned in any particular order.
+         */
+        Components computeComponentsInParallel() const {
+            Components result(getMaxId() + 1);
+            if (m_initialState == NULL)
+                return result;
+            
+            std::vector<StateT*> statesById(getMaxId() + 1, NULL);
+            typename StateSet::const_iterator sIt, sEnd;
+            for (sIt = m_states.begin(), sEnd = m_states.end(); sIt != sEnd; ++sIt) {
+                StateT* state = *sIt;
+                statesById[state->getId()] = state;
+            }
+            
+            LabelIndex labels;
+            const ForwardBackwardComponents components(LabeledGraph::build(*this, labels), m_initialState->getId());
+            for (size_t component = 0; component < components.getComponentCount(); ++component) {
+                const ForwardBackwardComponents::IndexRange members = components.getMembers(component);
+                ForwardBackwardComponents::IndexIterator mIt;
+                for (mIt = members.first; mIt != members.second; ++mIt)
+                    result.addState(statesById[*mIt]);
+                result.closeComponent();
+            }
+            
+            return result;
+        }
+        
+        /**
+         Indicates whether this automaton simulates the given automaton, i.e., whether the initial
+         state of this automaton simulates the initial state of the given automaton.
+         */
         template <class Other>
         bool simulates(const Other& other) const {
-            typedef std::pair<const StateT*, const typename Other::State*> Pair;
-            typedef std::set<Pair> Relation;
-            Relation relation;
+            if (m_initialState == NULL || other.getInitialState() == NULL)
+                return false;
             
-            return simulates(m_initialState, other.getInitialState(), relation);
+            LabelIndex labels;
+            const LabeledGraph simulator = LabeledGraph::build(*this, labels);
+            const LabeledGraph simulatee = LabeledGraph::build(other, labels);
+            const Simulation simulation(simulator, simulatee);
+            return simulation.simulates(m_initialState->getId(), other.getInitialState()->getId());
         }
         
+        /**
+         Indicates whether this automaton weakly simulates the given automaton. Unobservable edges
+         of the given automaton must be matched by sequences of unobservable edges of this
+         automaton, and observable edges must be matched by an edge with the same label that may be
+         preceded and followed by unobservable edges.
+         */
         template <class Other>
         bool weaklySimulates(const Other& other) const {
-            typedef std::pair<const StateT*, const typename Other::State*> Pair;
-            typedef std::set<Pair> Relation;
-            Relation relation;
+            if (m_initialState == NULL || other.getInitialState() == NULL)
+                return false;
             
-            return weaklySimulates(m_initialState, other.getInitialState(), relation);
+            LabelIndex labels;
+            const size_t tau = labels.getIndex(Label());
+            const LabeledGraph simulator = LabeledGraph::build(*this, labels);
+            const LabeledGraph simulatee = LabeledGraph::build(other, labels);
+            const Simulation simulation(simulator, simulatee, tau);
+            return simulation.simulates(m_initialState->getId(), other.getInitialState()->getId());
         }
     protected:
         void replaceState(StateT* oldState, StateT* newState) {
@@ -756,21 +1041,14 @@ namespace Tippi {
                 m_finalStates.insert(newState);
             }
             
-            delete oldState;
+            m_statePool.destroy(oldState);
         }
     private:
-        StateT* findState(StateT& state) const {
-            typename StateSet::const_iterator it = m_states.lower_bound(&state);
-            if (it == m_states.end() || !SetUtils::equals(m_states, &state, *it))
-                return NULL;
-            return *it;
-        }
-        
         StateT* addState(StateT* state) {
             assert(state != NULL);
             
             if (!m_states.insert(state).second) {
-                delete state;
+                m_statePool.destroy(state);
                 throw AutomatonException("Cannot add the same state twice");
             }
             setStateId(state);
@@ -778,21 +1056,6 @@ namespace Tippi {
             return state;
         }
         
-        std::pair<StateT*, bool> findOrAddState(StateT* state) {
-            assert(state != NULL);
-            
-            typename StateSet::iterator it = m_states.lower_bound(state);
-            if (it != m_states.end() && SetUtils::equals(m_states, state, *it)) {
-                delete state;
-                return std::make_pair(*it, false);
-            }
-            
-            m_states.insert(it, state);
-            setStateId(state);
-            stateWasAdded(state);
-            return std::make_pair(state, true);
-        }
-
         void setStateId(StateT* state) {
             state->setId(m_nextId++);
         }
@@ -805,7 +1068,7 @@ namespace Tippi {
 
             typename EdgeSet::iterator it = m_edges.lower_bound(edge);
             if (it != m_edges.end() && SetUtils::equals(m_edges, edge, *it)) {
-                delete edge;
+                m_edgePool.destroy(edge);
                 return *it;
             }
             
@@ -819,6 +1082,33 @@ namespace Tippi {
         
         virtual void edgeWasAdded(EdgeT* edge) {}
 
+        static void removeStates(StateSet& states, const BitSet& removed) {
+            StateSet remainingStates;
+            typename StateSet::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it) {
+                StateT* state = *it;
+                if (!removed.test(state->getId()))
+                    remainingStates.insert(remainingStates.end(), state);
+            }
+            states.swap(remainingStates);
+        }
+        
+        template <typename I>
+        void destroyStates(I cur, I end) {
+            while (cur != end) {
+                m_statePool.destroy(*cur);
+                ++cur;
+            }
+        }
+        
+        template <typename I>
+        void destroyEdges(I cur, I end) {
+            while (cur != end) {
+                m_edgePool.destroy(*cur);
+                ++cur;
+            }
+        }
+        
         void deleteIncomingEdges(StateT* state) {
             const typename StateT::IncomingList& incomingEdges = state->getIncoming();
             typename StateT::IncomingList::const_iterator it, end;
@@ -826,7 +1116,7 @@ namespace Tippi {
                 EdgeT* edge = *it;
                 SetUtils::remove(m_edges, edge);
                 edge->removeFromSource();
-                delete edge;
+                m_edgePool.destroy(edge);
             }
         }
         
@@ -837,73 +1127,8 @@ namespace Tippi {
                 EdgeT* edge = *it;
                 SetUtils::remove(m_edges, edge);
                 edge->removeFromTarget();
-                delete edge;
-            }
-        }
-
-        template <typename Other, typename Relation>
-        bool simulates(const StateT* mine, const Other* other, Relation& relation) const {
-            if (mine == NULL || other == NULL)
-                return false;
-            
-            assert(mine != NULL);
-            assert(other != NULL);
-            if (!relation.insert(std::make_pair(mine, other)).second)
-                return true;
-            
-            typename StateT::OutgoingList::const_iterator mIt, mEnd;
-            typename Other::OutgoingList::const_iterator oIt, oEnd;
-            
-            const typename Other::OutgoingList& otherEdges = other->getOutgoing();
-            
-            for (oIt = otherEdges.begin(), oEnd = otherEdges.end(); oIt != oEnd; ++oIt) {
-                const typename Other::Outgoing* otherEdge = *oIt;
-                const Other* otherSuccessor = otherEdge->getTarget();
-                const String& label = otherEdge->getLabel();
-                
-                const StateT* mineSuccessor = mine->findDirectSuccessor(label);
-                if (mineSuccessor == NULL)
-                    return false;
-                if (!simulates(mineSuccessor, otherSuccessor, relation))
-                    return false;
-            }
-            
-            return true;
-        }
-        
-        template <typename Other, typename Relation>
-        bool weaklySimulates(const StateT* mine, const Other* other, Relation& relation) const {
-            if (mine == NULL || other == NULL)
-                return false;
-            
-            assert(mine != NULL);
-            assert(other != NULL);
-            if (!relation.insert(std::make_pair(mine, other)).second)
-                return true;
-            
-            typename StateT::OutgoingList::const_iterator mIt, mEnd;
-            typename Other::OutgoingList::const_iterator oIt, oEnd;
-            
-            const typename Other::OutgoingList& otherEdges = other->getOutgoing();
-            
-            for (oIt = otherEdges.begin(), oEnd = otherEdges.end(); oIt != oEnd; ++oIt) {
-                const typename Other::Outgoing* otherEdge = *oIt;
-                const Other* otherSuccessor = otherEdge->getTarget();
-                if (!otherEdge->isObservable()) {
-                    if (!weaklySimulates(mine, otherSuccessor, relation))
-                        return false;
-                } else {
-                    const String& label = otherEdge->getLabel();
-                    
-                    const StateT* mineSuccessor = mine->findIndirectSuccessor(label);
-                    if (mineSuccessor == NULL)
-                        return false;
-                    if (!weaklySimulates(mineSuccessor, otherSuccessor, relation))
-                        return false;
-                }
+                m_edgePool.destroy(edge);
             }
-            
-            return true;
         }
     };
 }
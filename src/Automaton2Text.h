@@ -41,9 +41,9 @@ namespace Tippi {
         
         template <class A>
         void writeEdges(const A* automaton, std::ostream& stream) const {
-            const typename A::EdgeSet& edges = automaton->getEdges();
+            const typename A::EdgeList edges = automaton->getSortedEdges();
             
-            typename A::EdgeSet::const_iterator it, end;
+            typename A::EdgeList::const_iterator it, end;
             for (it = edges.begin(), end = edges.end(); it != end; ++it) {
                 const typename A::Edge* edge = *it;
                 stream << "TRANSITION " << edge->getLabel() << "; FROM " << edge->getSource()->getId() << "; TO " << edge->getTarget()->getId() << ";" << std::endl;
@@ -0,0 +1,222 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__AutomatonView__
+#define __Tippi__AutomatonView__
+
+#include "BitSet.h"
+
+#include <cassert>
+#include <vector>
+
+namespace Tippi {
+    /**
+     A read only view of an automaton which shows a subset of its states. The visible states are
+     marked in a bit set that is indexed by the state ids, and an edge is visible if both its source
+     and its target are visible. Hiding states neither copies nor modifies the automaton, so several
+     views of different parts of the same automaton can exist at the same time.
+     
+     A view provides the same read only interface as an automaton for the writers, i.e., the states,
+     the sorted edges, the initial state and the final states, and it presents the automaton as if
+     the hidden states had been deleted from it.
+     
+     @tparam A the type of the automaton
+     */
+    template <class A>
+    class AutomatonView {
+    public:
+        typedef typename A::State State;
+        typedef typename A::Edge Edge;
+        typedef typename A::EdgeList EdgeList;
+        typedef typename A::Components Components;
+        typedef std::vector<State*> StateList;
+    private:
+        const A& m_automaton;
+        BitSet m_visible;
+    public:
+        /**
+         Creates a view of the given automaton in which all states are visible.
+         */
+        AutomatonView(const A& automaton) :
+        m_automaton(automaton),
+        m_visible(automaton.getMaxId() + 1) {
+            const typename A::StateSet& states = m_automaton.getStates();
+            typename A::StateSet::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it)
+                m_visible.set((*it)->getId());
+        }
+        
+        /**
+         Creates a view of the given automaton which shows the states whose ids are set in the given
+         bit set.
+         */
+        AutomatonView(const A& automaton, const BitSet& visible) :
+        m_automaton(automaton),
+        m_visible(visible) {
+            assert(m_visible.size() == automaton.getMaxId() + 1);
+        }
+        
+        const A& getAutomaton() const {
+            return m_automaton;
+        }
+        
+        const BitSet& getVisibleStates() const {
+            return m_visible;
+        }
+        
+        size_t getMaxId() const {
+            return m_automaton.getMaxId();
+        }
+        
+        bool isVisible(const State* state) const {
+            return m_visible.test(state->getId());
+        }
+        
+        bool isVisible(const Edge* edge) const {
+            return isVisible(edge->getSource()) && isVisible(edge->getTarget());
+        }
+        
+        void hide(const State* state) {
+            m_visible.reset(state->getId());
+        }
+        
+        /**
+         Hides every visible state that satisfies the given predicate.
+         */
+        template <class P>
+        AutomatonView& hideIf(const P& predicate) {
+            const typename A::StateSet& states = m_automaton.getStates();
+            typename A::StateSet::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it) {
+                const State* state = *it;
+                if (isVisible(state) && predicate(state))
+                    hide(state);
+            }
+            return *this;
+        }
+        
+        /**
+         Hides every state which cannot be reached from the initial state by visible edges. If the
+         initial state is hidden, all states are hidden.
+         */
+        AutomatonView& hideUnreachable() {
+            BitSet reachable(m_visible.size());
+            std::vector<const State*> queue;
+            
+            const State* initialState = getInitialState();
+            if (initialState != NULL) {
+                reachable.set(initialState->getId());
+                queue.push_back(initialState);
+            }
+            
+            for (size_t i = 0; i < queue.size(); ++i) {
+                const typename State::OutgoingList& outgoing = queue[i]->getOutgoing();
+                typename State::OutgoingList::const_iterator it, end;
+                for (it = outgoing.begin(), end = outgoing.end(); it != end; ++it) {
+                    const State* target = (*it)->getTarget();
+                    if (isVisible(target) && reachable.testAndSet(target->getId()))
+                        queue.push_back(target);
+                }
+            }
+            
+            m_visible = reachable;
+            return *this;
+        }
+        
+        /**
+         Hides every state which is not part of the given strongly connected component.
+         */
+        AutomatonView& restrictTo(const Components& components, const size_t component) {
+            BitSet members(m_visible.size());
+            const typename Components::StateRange states = components.getStates(component);
+            typename Components::StateIterator it;
+            for (it = states.first; it != states.second; ++it) {
+                const State* state = *it;
+                if (isVisible(state))
+                    members.set(state->getId());
+            }
+            
+            m_visible = members;
+            return *this;
+        }
+        
+        /**
+         Returns the visible states in the order of the automaton's state set.
+         */
+        StateList getStates() const {
+            return filter(m_automaton.getStates(), true);
+        }
+        
+        /**
+         Returns the hidden states in the order of the automaton's state set.
+         */
+        StateList getHiddenStates() const {
+            return filter(m_automaton.getStates(), false);
+        }
+        
+        EdgeList getSortedEdges() const {
+            const EdgeList edges = m_automaton.getSortedEdges();
+            EdgeList result;
+            result.reserve(edges.size());
+            
+            typename EdgeList::const_iterator it, end;
+            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+                Edge* edge = *it;
+                if (isVisible(edge))
+                    result.push_back(edge);
+            }
+            return result;
+        }
+        
+        State* getInitialState() const {
+            State* initialState = m_automaton.getInitialState();
+            if (initialState == NULL || !isVisible(initialState))
+                return NULL;
+            return initialState;
+        }
+        
+        StateList getFinalStates() const {
+            return filter(m_automaton.getFinalStates(), true);
+        }
+        
+        /**
+         Computes the strongly connected components of the visible states which are reachable from
+         the initial state by visible edges.
+         */
+        Components computeComponents() const {
+            if (getInitialState() == NULL)
+                return Components(getMaxId() + 1);
+            return m_automaton.computeComponents(m_visible);
+        }
+    private:
+        template <class C>
+        StateList filter(const C& states, const bool visible) const {
+            StateList result;
+            typename C::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it) {
+                State* state = *it;
+                if (isVisible(state) == visible)
+                    result.push_back(state);
+            }
+            return result;
+        }
+    };
+}
+
+#endif /* defined(__Tippi__AutomatonView__) */
@@ -25,7 +25,7 @@
 #include <cassert>
 
 namespace Tippi {
-    BehaviorEdge::BehaviorEdge(BehaviorState* source, BehaviorState* target, const String& label) :
+    BehaviorEdge::BehaviorEdge(BehaviorState* source, BehaviorState* target, const Label& label) :
     AutomatonEdge(source, target, label) {}
     
     BehaviorEdge::BehaviorEdge(BehaviorState* source, BehaviorState* target) :
@@ -36,7 +36,7 @@ namespace Tippi {
     public:
         typedef std::vector<BehaviorEdge*> List;
     public:
-        BehaviorEdge(BehaviorState* source, BehaviorState* target, const String& label);
+        BehaviorEdge(BehaviorState* source, BehaviorState* target, const Label& label);
         BehaviorEdge(BehaviorState* source, BehaviorState* target);
     };
     
@@ -67,7 +67,7 @@ namespace Tippi {
     
     class Behavior : public Automaton<BehaviorState, BehaviorEdge> {
     public:
-        typedef std::tr1::shared_ptr<Behavior> Ptr;
+        typedef std::shared_ptr<Behavior> Ptr;
     private:
         BehaviorState* m_boundViolationState;
     public:
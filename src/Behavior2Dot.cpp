@@ -52,7 +52,7 @@ namespace Tippi {
             const BehaviorState* target = edge->getTarget();
             
             m_stream << getStateId(source) << " -> " << getStateId(target) << " [";
-            printAttribute("label", edge->getLabel());
+            printAttribute("label", edge->getLabel().getName());
             m_stream << "];" << std::endl;
         }
     private:
@@ -75,9 +75,9 @@ namespace Tippi {
         
         BehaviorVisitor visitor(stream);
         const Behavior::StateSet& states = behavior->getStates();
-        BehaviorState::resetVisited(states.begin(), states.end());
         
-        BreadthFirst<BehaviorVisitor, BehaviorVisitor> visitStates(visitor, visitor);
+        VisitedSet<> visited(behavior->getMaxId() + 1);
+        BreadthFirst<BehaviorVisitor, BehaviorVisitor> visitStates(visitor, visitor, visited);
         
         Behavior::StateSet::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
@@ -0,0 +1,257 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bisimulation.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Tippi {
+    Bisimulation::RefinablePartition::RefinablePartition(const size_t elementCount) :
+    m_elements(elementCount),
+    m_locations(elementCount),
+    m_sets(elementCount, 0),
+    m_marked(elementCount > 0 ? 1 : 0, 0) {
+        for (size_t i = 0; i < elementCount; ++i)
+            m_elements[i] = m_locations[i] = i;
+        if (elementCount > 0) {
+            m_first.push_back(0);
+            m_past.push_back(elementCount);
+        }
+    }
+    
+    struct KeyLess {
+        const std::vector<size_t>& keys;
+        
+        KeyLess(const std::vector<size_t>& i_keys) :
+        keys(i_keys) {}
+        
+        bool operator()(const size_t lhs, const size_t rhs) const {
+            return keys[lhs] < keys[rhs];
+        }
+    };
+    
+    void Bisimulation::RefinablePartition::splitByKey(const IndexList& keys) {
+        assert(keys.size() == m_elements.size());
+        
+        const size_t setCount = getSetCount();
+        for (size_t set = 0; set < setCount; ++set) {
+            const size_t first = m_first[set];
+            const size_t past = m_past[set];
+            std::sort(m_elements.begin() + first, m_elements.begin() + past, KeyLess(keys));
+            
+            // the first run of equal keys stays in the original set
+            size_t start = first;
+            for (size_t i = first; i <= past; ++i) {
+                if (i < past)
+                    m_locations[m_elements[i]] = i;
+                if (i == past || keys[m_elements[i]] != keys[m_elements[start]]) {
+                    if (start == first) {
+                        m_past[set] = i;
+                    } else {
+                        const size_t newSet = getSetCount();
+                        m_first.push_back(start);
+                        m_past.push_back(i);
+                        m_marked.push_back(0);
+                        for (size_t j = start; j < i; ++j)
+                            m_sets[m_elements[j]] = newSet;
+                    }
+                    start = i;
+                }
+            }
+        }
+    }
+    
+    size_t Bisimulation::RefinablePartition::getSetCount() const {
+        return m_first.size();
+    }
+    
+    size_t Bisimulation::RefinablePartition::getSet(const size_t element) const {
+        return m_sets[element];
+    }
+    
+    size_t Bisimulation::RefinablePartition::getFirst(const size_t set) const {
+        return m_first[set];
+    }
+    
+    size_t Bisimulation::RefinablePartition::getPast(const size_t set) const {
+        return m_past[set];
+    }
+    
+    size_t Bisimulation::RefinablePartition::getElement(const size_t location) const {
+        return m_elements[location];
+    }
+    
+    void Bisimulation::RefinablePartition::mark(const size_t element) {
+        const size_t set = m_sets[element];
+        const size_t location = m_locations[element];
+        const size_t markedLocation = m_first[set] + m_marked[set];
+        if (location < markedLocation)
+            return;
+        
+        // move the element to the end of the marked part of its set
+        m_elements[location] = m_elements[markedLocation];
+        m_locations[m_elements[location]] = location;
+        m_elements[markedLocation] = element;
+        m_locations[element] = markedLocation;
+        
+        if (m_marked[set]++ == 0)
+            m_touched.push_back(set);
+    }
+    
+    void Bisimulation::RefinablePartition::split() {
+        while (!m_touched.empty()) {
+            const size_t set = m_touched.back();
+            m_touched.pop_back();
+            
+            const size_t boundary = m_first[set] + m_marked[set];
+            if (boundary == m_past[set]) {
+                m_marked[set] = 0;
+                continue;
+            }
+            
+            // the smaller part becomes the new set
+            const size_t newSet = getSetCount();
+            if (m_marked[set] <= m_past[set] - boundary) {
+                m_first.push_back(m_first[set]);
+                m_past.push_back(boundary);
+                m_first[set] = boundary;
+            } else {
+                m_first.push_back(boundary);
+                m_past.push_back(m_past[set]);
+                m_past[set] = boundary;
+            }
+            m_marked.push_back(0);
+            m_marked[set] = 0;
+            
+            for (size_t i = m_first[newSet]; i < m_past[newSet]; ++i)
+                m_sets[m_elements[i]] = newSet;
+        }
+    }
+    
+    static const size_t None = static_cast<size_t>(-1);
+    
+    Bisimulation::Bisimulation(const LabeledGraph& graph, const std::vector<size_t>& initialClasses) {
+        const size_t stateCount = graph.getStateCount();
+        assert(initialClasses.size() == stateCount);
+        
+        // number the transitions in the order of the successor arrays
+        std::vector<size_t> sources;
+        std::vector<size_t> labels;
+        std::vector<size_t> targets;
+        for (size_t state = 0; state < stateCount; ++state) {
+            const LabeledGraph::TransitionRange successors = graph.getSuccessors(state);
+            LabeledGraph::TransitionIterator it;
+            for (it = successors.first; it != successors.second; ++it) {
+                sources.push_back(state);
+                labels.push_back(it->label);
+                targets.push_back(it->state);
+            }
+        }
+        const size_t transitionCount = sources.size();
+        
+        // the incoming transitions of each state
+        std::vector<size_t> incomingOffsets(stateCount + 1, 0);
+        for (size_t t = 0; t < transitionCount; ++t)
+            ++incomingOffsets[targets[t] + 1];
+        for (size_t state = 0; state < stateCount; ++state)
+            incomingOffsets[state + 1] += incomingOffsets[state];
+        std::vector<size_t> incoming(transitionCount);
+        std::vector<size_t> next(incomingOffsets.begin(), incomingOffsets.end() - 1);
+        for (size_t t = 0; t < transitionCount; ++t)
+            incoming[next[targets[t]]++] = t;
+        
+        RefinablePartition blocks(stateCount);
+        blocks.splitByKey(initialClasses);
+        RefinablePartition cords(transitionCount);
+        cords.splitByKey(labels);
+        
+        // Each transition refers to a counter which holds the number of transitions of its source
+        // state in the set of transitions that shared its cord when that cord was last used as a
+        // splitter. The blocks are stable with respect to these sets.
+        std::vector<size_t> cells(transitionCount, None);
+        std::vector<size_t> counters;
+        std::vector<size_t> newCells(stateCount, None);
+        std::vector<size_t> oldCells(stateCount, None);
+        std::vector<size_t> splitSources;
+        
+        // The first block needs not be used to split the cords because splitting a cord by all
+        // other blocks also separates the transitions into the first block.
+        size_t block = 1;
+        size_t cord = 0;
+        while (cord < cords.getSetCount()) {
+            // split the blocks into the sources of the cord and the other states
+            for (size_t i = cords.getFirst(cord); i < cords.getPast(cord); ++i) {
+                const size_t transition = cords.getElement(i);
+                const size_t source = sources[transition];
+                if (newCells[source] == None) {
+                    newCells[source] = counters.size();
+                    oldCells[source] = cells[transition];
+                    counters.push_back(0);
+                    splitSources.push_back(source);
+                    blocks.mark(source);
+                }
+                
+                ++counters[newCells[source]];
+                if (cells[transition] != None)
+                    --counters[cells[transition]];
+                cells[transition] = newCells[source];
+            }
+            blocks.split();
+            
+            // If the cord was split off from a set of transitions that was used as a splitter
+            // before, separate the sources that still have transitions in the rest of that set.
+            std::vector<size_t>::const_iterator it, end;
+            for (it = splitSources.begin(), end = splitSources.end(); it != end; ++it) {
+                const size_t source = *it;
+                if (oldCells[source] != None && counters[oldCells[source]] > 0)
+                    blocks.mark(source);
+                newCells[source] = None;
+            }
+            blocks.split();
+            splitSources.clear();
+            ++cord;
+            
+            // split the cords by the targets of their transitions
+            while (block < blocks.getSetCount()) {
+                for (size_t i = blocks.getFirst(block); i < blocks.getPast(block); ++i) {
+                    const size_t state = blocks.getElement(i);
+                    for (size_t j = incomingOffsets[state]; j < incomingOffsets[state + 1]; ++j)
+                        cords.mark(incoming[j]);
+                }
+                cords.split();
+                ++block;
+            }
+        }
+        
+        m_blockCount = blocks.getSetCount();
+        m_blocks.resize(stateCount);
+        for (size_t state = 0; state < stateCount; ++state)
+            m_blocks[state] = blocks.getSet(state);
+    }
+    
+    size_t Bisimulation::getBlockCount() const {
+        return m_blockCount;
+    }
+    
+    size_t Bisimulation::getBlock(const size_t state) const {
+        assert(state < m_blocks.size());
+        return m_blocks[state];
+    }
+}
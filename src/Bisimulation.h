@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__Bisimulation__
+#define __Tippi__Bisimulation__
+
+#include "Simulation.h"
+
+#include <vector>
+
+namespace Tippi {
+    /**
+     Computes the coarsest strong bisimulation of a labeled graph that refines a given initial
+     partition of its states. The implementation follows Valmari's partition refinement algorithm,
+     which runs in O(m log n) time. It maintains two refinable partitions, one of the states (the
+     blocks) and one of the transitions (the cords). Each cord contains transitions with the same
+     label whose targets lie in the same block. The sources of the transitions of each cord are
+     used to split the blocks, and the incoming transitions of the smaller parts of split blocks
+     are used to split the cords, until both partitions are stable.
+     
+     Since the automata may be nondeterministic, a block that is split by a cord which was split
+     off from a previous splitter is split three ways as in the Paige-Tarjan algorithm. Counters of
+     the transitions of each state in the previous splitters tell which states still have
+     transitions in the remainder of the previous splitter.
+     */
+    class Bisimulation {
+    private:
+        class RefinablePartition {
+        private:
+            typedef std::vector<size_t> IndexList;
+            
+            IndexList m_elements;
+            IndexList m_locations;
+            IndexList m_sets;
+            IndexList m_first;
+            IndexList m_past;
+            IndexList m_marked;
+            IndexList m_touched;
+        public:
+            RefinablePartition(size_t elementCount);
+            
+            /**
+             Splits the partition such that two elements are in the same set if and only if their
+             given keys are equal and they were in the same set before.
+             */
+            void splitByKey(const IndexList& keys);
+            
+            size_t getSetCount() const;
+            size_t getSet(size_t element) const;
+            size_t getFirst(size_t set) const;
+            size_t getPast(size_t set) const;
+            size_t getElement(size_t location) const;
+            
+            void mark(size_t element);
+            void split();
+        };
+        
+        std::vector<size_t> m_blocks;
+        size_t m_blockCount;
+    public:
+        /**
+         Computes the bisimulation.
+         
+         @param graph the graph
+         @param initialClasses the initial classes of the states; two states can only be bisimilar
+         if they have the same initial class
+         */
+        Bisimulation(const LabeledGraph& graph, const std::vector<size_t>& initialClasses);
+        
+        size_t getBlockCount() const;
+        size_t getBlock(size_t state) const;
+    };
+}
+
+#endif /* defined(__Tippi__Bisimulation__) */
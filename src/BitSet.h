@@ -0,0 +1,224 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__BitSet__
+#define __Tippi__BitSet__
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace Tippi {
+    /**
+     A fixed size set of bits which is stored in machine words. In contrast to std::vector<bool>,
+     this class allows counting the set bits and combining two bit sets word by word.
+     */
+    class BitSet {
+    public:
+        typedef unsigned long Word;
+        static const size_t WordBits = sizeof(Word) * 8;
+    private:
+        std::vector<Word> m_words;
+        size_t m_size;
+    public:
+        /**
+         Creates a new bit set with the given number of bits, all of which are cleared.
+         
+         @param size the number of bits
+         */
+        BitSet(const size_t size = 0) :
+        m_words((size + WordBits - 1) / WordBits, 0),
+        m_size(size) {}
+        
+        /**
+         Returns the number of bits in this bit set.
+         */
+        size_t size() const {
+            return m_size;
+        }
+        
+        /**
+         Changes the number of bits in this bit set. Newly added bits are cleared.
+         
+         @param size the new number of bits
+         */
+        void resize(const size_t size) {
+            if (size < m_size) {
+                m_words.resize((size + WordBits - 1) / WordBits);
+                m_size = size;
+                clearTrailingBits();
+            } else {
+                m_words.resize((size + WordBits - 1) / WordBits, 0);
+                m_size = size;
+            }
+        }
+        
+        bool test(const size_t index) const {
+            assert(index < m_size);
+            return (m_words[index / WordBits] & mask(index)) != 0;
+        }
+        
+        void set(const size_t index) {
+            assert(index < m_size);
+            m_words[index / WordBits] |= mask(index);
+        }
+        
+        void reset(const size_t index) {
+            assert(index < m_size);
+            m_words[index / WordBits] &= ~mask(index);
+        }
+        
+        /**
+         Sets the bit at the given index and returns whether it was cleared before.
+         
+         @param index the index of the bit to set
+         @return true if the bit was cleared before and false otherwise
+         */
+        bool testAndSet(const size_t index) {
+            assert(index < m_size);
+            Word& word = m_words[index / WordBits];
+            const Word bit = mask(index);
+            if ((word & bit) != 0)
+                return false;
+            word |= bit;
+            return true;
+        }
+        
+        /**
+         Clears all bits.
+         */
+        void clear() {
+            std::fill(m_words.begin(), m_words.end(), 0);
+        }
+        
+        /**
+         Sets all bits.
+         */
+        void fill() {
+            std::fill(m_words.begin(), m_words.end(), ~static_cast<Word>(0));
+            clearTrailingBits();
+        }
+        
+        /**
+         Returns the number of set bits.
+         */
+        size_t count() const {
+            size_t result = 0;
+            for (size_t i = 0; i < m_words.size(); ++i)
+                result += popCount(m_words[i]);
+            return result;
+        }
+        
+        bool none() const {
+            for (size_t i = 0; i < m_words.size(); ++i)
+                if (m_words[i] != 0)
+                    return false;
+            return true;
+        }
+        
+        bool any() const {
+            return !none();
+        }
+        
+        /**
+         Returns the index of the first set bit whose index is not less than the given index, or
+         size() if there is no such bit.
+         
+         @param index the index to start searching at
+         @return the index of the next set bit
+         */
+        size_t findNext(const size_t index) const {
+            if (index >= m_size)
+                return m_size;
+            size_t wordIndex = index / WordBits;
+            Word word = m_words[wordIndex] & (~static_cast<Word>(0) << (index % WordBits));
+            while (word == 0) {
+                if (++wordIndex == m_words.size())
+                    return m_size;
+                word = m_words[wordIndex];
+            }
+            return wordIndex * WordBits + trailingZeros(word);
+        }
+        
+        size_t findFirst() const {
+            return findNext(0);
+        }
+        
+        /**
+         Removes all bits from this bit set that are not set in the given bit set. Both bit sets
+         must have the same size.
+         */
+        BitSet& operator&=(const BitSet& other) {
+            assert(m_size == other.m_size);
+            for (size_t i = 0; i < m_words.size(); ++i)
+                m_words[i] &= other.m_words[i];
+            return *this;
+        }
+        
+        /**
+         Adds all bits to this bit set that are set in the given bit set. Both bit sets must have
+         the same size.
+         */
+        BitSet& operator|=(const BitSet& other) {
+            assert(m_size == other.m_size);
+            for (size_t i = 0; i < m_words.size(); ++i)
+                m_words[i] |= other.m_words[i];
+            return *this;
+        }
+        
+        bool operator==(const BitSet& other) const {
+            return m_size == other.m_size && m_words == other.m_words;
+        }
+        
+        bool operator!=(const BitSet& other) const {
+            return !(*this == other);
+        }
+    private:
+        static Word mask(const size_t index) {
+            return static_cast<Word>(1) << (index % WordBits);
+        }
+        
+        void clearTrailingBits() {
+            const size_t trailing = m_size % WordBits;
+            if (trailing != 0)
+                m_words.back() &= ~(~static_cast<Word>(0) << trailing);
+        }
+        
+        static size_t popCount(Word word) {
+            size_t result = 0;
+            while (word != 0) {
+                word &= word - 1;
+                ++result;
+            }
+            return result;
+        }
+        
+        static size_t trailingZeros(Word word) {
+            assert(word != 0);
+            size_t result = 0;
+            while ((word & 1) == 0) {
+                word >>= 1;
+                ++result;
+            }
+            return result;
+        }
+    };
+}
+
+#endif /* defined(__Tippi__BitSet__) */
@@ -0,0 +1,179 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BitStateSearch.h"
+
+#include "IntervalNet.h"
+#include "IntervalNetFiringRule.h"
+#include "IntervalNetState.h"
+
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+namespace Tippi {
+    const size_t BitStateSearch::DefaultLog2BitCount = 27;
+    // 2^40 bits are 128 GiB, which is more than any machine this runs on can allocate anyway
+    const size_t BitStateSearch::MaxLog2BitCount = sizeof(size_t) * 8 - 2 < 40 ? sizeof(size_t) * 8 - 2 : 40;
+    
+    BitStateSearch::Result::Result(const size_t i_bitCount) :
+    stateCount(0),
+    storedStateCount(0),
+    transitionCount(0),
+    deadlockCount(0),
+    finalStateCount(0),
+    boundViolationCount(0),
+    maxDepth(0),
+    bitCount(i_bitCount),
+    setBitCount(0),
+    partialCollisionCount(0),
+    estimatedCollisionCount(0.0) {}
+    
+    double BitStateSearch::Result::getHashFactor() const {
+        if (storedStateCount == 0)
+            return 0.0;
+        return static_cast<double>(bitCount) / static_cast<double>(storedStateCount);
+    }
+    
+    double BitStateSearch::Result::getCoverage() const {
+        if (storedStateCount == 0)
+            return 1.0;
+        return static_cast<double>(storedStateCount) / (static_cast<double>(storedStateCount) + estimatedCollisionCount);
+    }
+    
+    BitStateSearch::BitStateSearch(const size_t log2BitCount) :
+    m_log2BitCount(log2BitCount) {
+        assert(m_log2BitCount > 0 && m_log2BitCount <= MaxLog2BitCount);
+    }
+    
+    struct SearchFrame {
+        Interval::NetState state;
+        size_t depth;
+        
+        SearchFrame(const Interval::NetState& i_state, const size_t i_depth) :
+        state(i_state),
+        depth(i_depth) {}
+    };
+    
+    BitStateSearch::Result BitStateSearch::operator()(const NetPtr net) const {
+        const size_t bitCount = static_cast<size_t>(1) << m_log2BitCount;
+        BitSet bits(bitCount);
+        Result result(bitCount);
+        
+        const Interval::FiringRule rule(*net);
+        
+        // The stack contains states which have been stored, but not yet expanded. Since states are
+        // expanded when they are popped, the search order is depth first.
+        std::vector<SearchFrame> stack;
+        const Interval::NetState initialState = Interval::NetState::createInitialState(*net);
+        if (storeState(initialState, bits, result))
+            stack.push_back(SearchFrame(initialState, 0));
+        
+        while (!stack.empty()) {
+            const SearchFrame frame = stack.back();
+            stack.pop_back();
+            
+            const Interval::NetState& state = frame.state;
+            result.maxDepth = std::max(result.maxDepth, frame.depth);
+            if (!state.isBounded(*net)) {
+                ++result.boundViolationCount;
+                continue;
+            }
+            
+            ++result.stateCount;
+            if (state.isFinalMarking(*net))
+                ++result.finalStateCount;
+            
+            std::vector<Interval::NetState> successors;
+            const Interval::Transition::List fireableTransitions = rule.getFireableTransitions(state);
+            Interval::Transition::List::const_iterator it, end;
+            for (it = fireableTransitions.begin(), end = fireableTransitions.end(); it != end; ++it) {
+                const Interval::Transition* transition = *it;
+                successors.push_back(rule.fireTransition(transition, state));
+            }
+            if (rule.canMakeTimeStep(state))
+                successors.push_back(rule.makeTimeStep(state));
+            
+            if (successors.empty())
+                ++result.deadlockCount;
+            result.transitionCount += successors.size();
+            
+            // push in reverse order so that the successors are expanded in the same order as in ConstructBehavior
+            std::vector<Interval::NetState>::const_reverse_iterator sIt, sEnd;
+            for (sIt = successors.rbegin(), sEnd = successors.rend(); sIt != sEnd; ++sIt) {
+                const Interval::NetState& successor = *sIt;
+                if (storeState(successor, bits, result))
+                    stack.push_back(SearchFrame(successor, frame.depth + 1));
+            }
+        }
+        
+        return result;
+    }
+    
+    bool BitStateSearch::storeState(const Interval::NetState& state, BitSet& bits, Result& result) const {
+        const HashUtils::Hash bitMask = bits.size() - 1;
+        
+        // Double hashing: the i-th index is h1 + i * h2, where both h1 and h2 are derived from a
+        // single well mixed 64 bit hash of the state. h2 is odd so that the indices are distinct.
+        const HashUtils::Hash h1 = state.hash64();
+        const HashUtils::Hash h2 = HashUtils::mix(h1) | 1;
+        
+        size_t indices[HashCount];
+        size_t setCount = 0;
+        for (size_t i = 0; i < HashCount; ++i) {
+            indices[i] = static_cast<size_t>((h1 + i * h2) & bitMask);
+            if (bits.test(indices[i]))
+                ++setCount;
+        }
+        
+        if (setCount == HashCount)
+            return false;
+        if (setCount > 0)
+            ++result.partialCollisionCount;
+        
+        // The probability that this state would have been mistaken for a visited state.
+        const double fillRatio = static_cast<double>(result.setBitCount) / static_cast<double>(result.bitCount);
+        double collisionProbability = 1.0;
+        for (size_t i = 0; i < HashCount; ++i)
+            collisionProbability *= fillRatio;
+        result.estimatedCollisionCount += collisionProbability;
+        
+        for (size_t i = 0; i < HashCount; ++i)
+            if (bits.testAndSet(indices[i]))
+                ++result.setBitCount;
+        ++result.storedStateCount;
+        return true;
+    }
+    
+    std::ostream& operator<<(std::ostream& stream, const BitStateSearch::Result& result) {
+        stream << "BITSTATE" << std::endl;
+        stream << "STATES " << result.stateCount << ";" << std::endl;
+        stream << "TRANSITIONS " << result.transitionCount << ";" << std::endl;
+        stream << "DEPTH " << result.maxDepth << ";" << std::endl;
+        stream << "DEADLOCKS " << result.deadlockCount << ";" << std::endl;
+        stream << "FINALSTATES " << result.finalStateCount << ";" << std::endl;
+        stream << "BOUNDVIOLATIONS " << result.boundViolationCount << ";" << std::endl;
+        stream << "BITS " << result.bitCount << ", " << result.setBitCount << " SET;" << std::endl;
+        stream << "HASHFACTOR " << std::fixed << std::setprecision(2) << result.getHashFactor() << ";" << std::endl;
+        stream << "COLLISIONS " << std::setprecision(2) << result.estimatedCollisionCount << " ESTIMATED, " << result.partialCollisionCount << " PARTIAL;" << std::endl;
+        stream << "COVERAGE " << std::setprecision(4) << 100.0 * result.getCoverage() << "%;" << std::endl;
+        stream.unsetf(std::ios_base::floatfield);
+        return stream;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__BitStateSearch__
+#define __Tippi__BitStateSearch__
+
+#include "SharedPointer.h"
+#include "BitSet.h"
+
+#include <iostream>
+
+namespace Tippi {
+    namespace Interval {
+        class FiringRule;
+        class Net;
+        class NetState;
+    }
+    
+    /**
+     Explores the state space of an interval net without storing the visited states. Instead, each
+     visited state is represented by a few bits in a fixed size bit array (bit state hashing or
+     supertrace). Two different states may be mapped to the same bits, in which case the second
+     state is considered to have been visited already and its successors may not be explored. The
+     search is therefore incomplete, but it requires only a fixed amount of memory.
+     
+     The result contains the number of bounded states that were visited along with the number of
+     deadlocks and final states that were found among them and the number of bound violations that
+     were reached. Since hash collisions cannot be detected directly, the number of collisions and
+     the coverage are estimated from the fill ratio of the bit array at the time each new state was
+     stored.
+     */
+    struct BitStateSearch {
+    public:
+        typedef std::shared_ptr<Interval::Net> NetPtr;
+        
+        struct Result {
+            size_t stateCount;
+            size_t storedStateCount;
+            size_t transitionCount;
+            size_t deadlockCount;
+            size_t finalStateCount;
+            size_t boundViolationCount;
+            size_t maxDepth;
+            size_t bitCount;
+            size_t setBitCount;
+            size_t partialCollisionCount;
+            double estimatedCollisionCount;
+            
+            Result(size_t i_bitCount);
+            
+            double getHashFactor() const;
+            double getCoverage() const;
+        };
+    private:
+        static const size_t HashCount = 2;
+        size_t m_log2BitCount;
+    public:
+        /**
+         Creates a new search which uses a bit array of 2^log2BitCount bits. The exponent must not
+         exceed MaxLog2BitCount. Since the bit array is allocated when the search is run, running
+         the search may throw std::bad_alloc if there is not enough memory.
+         
+         @param log2BitCount the binary logarithm of the number of bits to use
+         */
+        BitStateSearch(size_t log2BitCount = DefaultLog2BitCount);
+        
+        Result operator()(const NetPtr net) const;
+        
+        static const size_t DefaultLog2BitCount;
+        static const size_t MaxLog2BitCount;
+    private:
+        bool storeState(const Interval::NetState& state, BitSet& bits, Result& result) const;
+    };
+    
+    std::ostream& operator<<(std::ostream& stream, const BitStateSearch::Result& result);
+}
+
+#endif /* defined(__Tippi__BitStateSearch__) */
@@ -19,14 +19,17 @@
 
 #include "Closure.h"
 
+#include "BitSet.h"
 #include "CollectionUtils.h"
 #include "Exceptions.h"
 
 #include <algorithm>
 #include <cassert>
+#include <utility>
+#include <vector>
 
 namespace Tippi {
-    ClosureEdge::ClosureEdge(ClosureState* source, ClosureState* target, const String& label, const EdgeType type) :
+    ClosureEdge::ClosureEdge(ClosureState* source, ClosureState* target, const Label& label, const EdgeType type) :
     AutomatonEdge(source, target, label),
     m_type(type) {}
     
@@ -35,15 +38,27 @@ namespace Tippi {
     }
     
     bool ClosureEdge::isServiceAction() const {
-        return m_type == EdgeType_OutputSend || m_type == EdgeType_InputRead;
+        return isServiceAction(m_type);
     }
     
     bool ClosureEdge::isPartnerAction() const {
-        return m_type == EdgeType_InputSend || m_type == EdgeType_OutputRead;
+        return isPartnerAction(m_type);
     }
     
     bool ClosureEdge::isTimeAction() const {
-        return m_type == EdgeType_Time;
+        return isTimeAction(m_type);
+    }
+    
+    bool ClosureEdge::isServiceAction(const EdgeType type) {
+        return type == EdgeType_OutputSend || type == EdgeType_InputRead;
+    }
+    
+    bool ClosureEdge::isPartnerAction(const EdgeType type) {
+        return type == EdgeType_InputSend || type == EdgeType_OutputRead;
+    }
+    
+    bool ClosureEdge::isTimeAction(const EdgeType type) {
+        return type == EdgeType_Time;
     }
     
     String ClosureEdge::asString() const {
@@ -56,8 +71,8 @@ namespace Tippi {
         return lhs.compare(rhs);
     }
     
-    ClosureState::ClosureState(const Closure& closure) :
-    m_closure(closure),
+    ClosureState::ClosureState(Closure closure) :
+    m_closure(std::move(closure)),
     m_safety(Safety_Unknown),
     m_reachable(true) {}
     
@@ -136,6 +151,34 @@ namespace Tippi {
         return m_closure.asString(markingSeparator, stateSeparator);
     }
     
+    unsigned char FrozenEdgeType<ClosureEdge>::get(const ClosureEdge* edge) {
+        return static_cast<unsigned char>(edge->getType());
+    }
+    
+    const size_t FrozenStateFlags<ClosureState>::FlagCount;
+    
+    bool FrozenStateFlags<ClosureState>::get(const ClosureState* state, const size_t flag) {
+        switch (flag) {
+            case Flag_Empty:
+                return state->isEmpty();
+            case Flag_BoundViolation:
+                return state->isBoundViolation();
+            case Flag_ContainsLoop:
+                return state->getClosure().containsLoop();
+            case Flag_Deadlock:
+                return state->isDeadlock();
+            case Flag_Stable:
+                return state->isStable();
+            case Flag_SafetyKnown:
+                return state->isSafetyKnown();
+            case Flag_Safe:
+                return state->isSafetyKnown() && state->isSafe();
+            default:
+                assert(false);
+                return false;
+        }
+    }
+    
     class StateCmp {
     public:
         bool operator()(const ClosureState* lhs, const ClosureState* rhs) const {
@@ -155,11 +198,11 @@ namespace Tippi {
     ClosureAutomaton::ClosureAutomaton() :
     m_boundViolationState(NULL) {}
     
-    ClosureState* ClosureAutomaton::boundViolationState(const Closure& closure) {
+    ClosureState* ClosureAutomaton::boundViolationState(Closure closure) {
         assert(closure.containsBoundViolation());
         
         if (m_boundViolationState == NULL) {
-            m_boundViolationState = createState(closure);
+            m_boundViolationState = createState(std::move(closure));
         } else {
             const Closure& oldClosure = m_boundViolationState->getClosure();
             Closure newClosure;
@@ -168,7 +211,7 @@ namespace Tippi {
             newClosure.setContainsBoundViolation();
             
             if (newClosure != oldClosure) {
-                ClosureState* newState = createState(newClosure);
+                ClosureState* newState = createState(std::move(newClosure));
                 replaceState(m_boundViolationState, newState);
                 m_boundViolationState = newState;
             }
@@ -178,47 +221,54 @@ namespace Tippi {
     }
     
     const ClosureState* ClosureAutomaton::findState(const Closure& closure) const {
-        ClosureState query(closure);
-        StateSet::const_iterator it = getStates().find(&query);
-        if (it == getStates().end())
-            return NULL;
-        return *it;
+        return Automaton<ClosureState, ClosureEdge>::findState(closure);
+    }
+    
+    bool IsUnsafeState::operator()(const ClosureState* state) const {
+        return state->isSafetyKnown() && !state->isSafe();
     }
     
     ClosureAutomaton::StateSet ClosureAutomaton::findUnsafeStates() const {
+        const IsUnsafeState isUnsafe;
         StateSet result;
         const StateSet& states = getStates();
         StateSet::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
             ClosureState* state = *it;
-            if (state->isSafetyKnown() && !state->isSafe())
+            if (isUnsafe(state))
                 result.insert(state);
         }
         return result;
     }
     
-    ClosureAutomaton::StateSet ClosureAutomaton::findUnreachableStates() const {
-        StateSet unreachable;
+    ClosureAutomaton::StateList ClosureAutomaton::findUnreachableStates() const {
+        BitSet reachable(getMaxId() + 1);
+        std::vector<const ClosureState*> queue;
         
-        size_t count;
-        do {
-            count = unreachable.size();
-            doFindUnreachableStates(unreachable);
-        } while (count < unreachable.size());
+        const ClosureState* initialState = getInitialState();
+        if (initialState != NULL) {
+            reachable.set(initialState->getId());
+            queue.push_back(initialState);
+        }
         
-        return unreachable;
-    }
-    
-    void ClosureAutomaton::doFindUnreachableStates(StateSet& unreachable) const {
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const ClosureState::OutgoingList& outgoing = queue[i]->getOutgoing();
+            ClosureState::OutgoingList::const_iterator eIt, eEnd;
+            for (eIt = outgoing.begin(), eEnd = outgoing.end(); eIt != eEnd; ++eIt) {
+                const ClosureState* target = (*eIt)->getTarget();
+                if (reachable.testAndSet(target->getId()))
+                    queue.push_back(target);
+            }
+        }
+        
+        StateList unreachable;
         const StateSet& states = getStates();
         StateSet::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
             ClosureState* state = *it;
-            if (state != getInitialState() &&
-                unreachable.count(state) == 0 &&
-                state->isPresetSubsetOfIgnoringLoops(unreachable))
-                unreachable.insert(state);
+            if (!reachable.test(state->getId()))
+                unreachable.push_back(state);
         }
-        
+        return unreachable;
     }
-}
\ No newline at end of file
+}
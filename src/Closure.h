@@ -17,12 +17,13 @@
  along with Tippi. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef __Tippi__Behavior__
-#define __Tippi__Behavior__
+#ifndef __Tippi__Closure__
+#define __Tippi__Closure__
 
 #include "SharedPointer.h"
 #include "StringUtils.h"
 #include "Automaton.h"
+#include "AutomatonView.h"
 #include "IntervalNetFiringRule.h"
 #include "IntervalNetState.h"
 
@@ -44,13 +45,17 @@ namespace Tippi {
     private:
         EdgeType m_type;
     public:
-        ClosureEdge(ClosureState* source, ClosureState* target, const String& label, EdgeType type);
+        ClosureEdge(ClosureState* source, ClosureState* target, const Label& label, EdgeType type);
         
         EdgeType getType() const;
         bool isServiceAction() const;
         bool isPartnerAction() const;
         bool isTimeAction() const;
         
+        static bool isServiceAction(EdgeType type);
+        static bool isPartnerAction(EdgeType type);
+        static bool isTimeAction(EdgeType type);
+        
         String asString() const;
     };
     
@@ -71,7 +76,7 @@ namespace Tippi {
         Safety m_safety;
         bool m_reachable;
     public:
-        ClosureState(const Closure& closure);
+        ClosureState(Closure closure);
         static const Key& getKey(const ClosureState* state);
         
         const Closure& getClosure() const;
@@ -92,23 +97,67 @@ namespace Tippi {
         String asString(const String& markingSeparator, const String& stateSeparator) const;
     };
     
+    /**
+     The edge type column of a frozen closure automaton stores the ClosureEdge::EdgeType of each
+     edge.
+     */
+    template <>
+    struct FrozenEdgeType<ClosureEdge> {
+        static unsigned char get(const ClosureEdge* edge);
+    };
+    
+    /**
+     The state flags of a frozen closure automaton. The safety flags record the safety of the
+     states at the time the snapshot was taken.
+     */
+    template <>
+    struct FrozenStateFlags<ClosureState> {
+        typedef enum {
+            Flag_Empty,
+            Flag_BoundViolation,
+            Flag_ContainsLoop,
+            Flag_Deadlock,
+            Flag_Stable,
+            Flag_SafetyKnown,
+            Flag_Safe
+        } Flag;
+        
+        static const size_t FlagCount = Flag_Safe + 1;
+        
+        static bool get(const ClosureState* state, size_t flag);
+    };
+    
+    /**
+     Indicates whether a closure state is known to be unsafe.
+     */
+    struct IsUnsafeState {
+        bool operator()(const ClosureState* state) const;
+    };
+    
     class ClosureAutomaton : public Automaton<ClosureState, ClosureEdge> {
     private:
         ClosureState* m_boundViolationState;
     public:
-        typedef std::tr1::shared_ptr<ClosureAutomaton> Ptr;
+        typedef std::shared_ptr<ClosureAutomaton> Ptr;
     public:
         ClosureAutomaton();
         
-        ClosureState* boundViolationState(const Closure& closure);
+        ClosureState* boundViolationState(Closure closure);
         
         const ClosureState* findState(const Closure& closure) const;
 
+        typedef AutomatonView<ClosureAutomaton> View;
+        typedef Tippi::FrozenAutomaton<ClosureState, ClosureEdge> FrozenAutomaton;
+        typedef FrozenStateFlags<ClosureState> FrozenFlags;
+        
         StateSet findUnsafeStates() const;
-        StateSet findUnreachableStates() const;
-    private:
-        void doFindUnreachableStates(StateSet& unreachable) const;
+        
+        /**
+         Returns the states that cannot be reached from the initial state. If there is no initial
+         state, all states are unreachable.
+         */
+        StateList findUnreachableStates() const;
     };
 }
 
-#endif /* defined(__Tippi__Behavior__) */
+#endif /* defined(__Tippi__Closure__) */
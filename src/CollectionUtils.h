@@ -21,10 +21,16 @@
 #define Tippi_CollectionUtils_h
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <new>
 #include <set>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Utils {
@@ -47,6 +53,453 @@ namespace Utils {
             return m_cmp(lhs, rhs);
         }
     };
+    
+    /**
+     A vector which stores up to N elements inline and only allocates memory on the heap if it
+     grows beyond that. Only the operations needed by FlatSet and FlatMap are provided.
+     */
+    template <typename T, size_t N>
+    class SmallVector {
+    public:
+        typedef T value_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef size_t size_type;
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+        
+        T* m_elements;
+        size_t m_size;
+        size_t m_capacity;
+        Storage m_inline[N > 0 ? N : 1];
+    public:
+        SmallVector() :
+        m_elements(inlineElements()),
+        m_size(0),
+        m_capacity(N) {}
+        
+        SmallVector(const SmallVector& other) :
+        SmallVector() {
+            reserve(other.m_size);
+            std::uninitialized_copy(other.begin(), other.end(), m_elements);
+            m_size = other.m_size;
+        }
+        
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        SmallVector() {
+            takeFrom(other);
+        }
+        
+        ~SmallVector() {
+            clear();
+            deallocate();
+        }
+        
+        SmallVector& operator=(const SmallVector& other) {
+            if (this != &other) {
+                clear();
+                reserve(other.m_size);
+                std::uninitialized_copy(other.begin(), other.end(), m_elements);
+                m_size = other.m_size;
+            }
+            return *this;
+        }
+        
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (this != &other) {
+                clear();
+                deallocate();
+                takeFrom(other);
+            }
+            return *this;
+        }
+        
+        iterator begin() { return m_elements; }
+        iterator end() { return m_elements + m_size; }
+        const_iterator begin() const { return m_elements; }
+        const_iterator end() const { return m_elements + m_size; }
+        
+        T& operator[](const size_t index) {
+            assert(index < m_size);
+            return m_elements[index];
+        }
+        
+        const T& operator[](const size_t index) const {
+            assert(index < m_size);
+            return m_elements[index];
+        }
+        
+        T& back() {
+            assert(m_size > 0);
+            return m_elements[m_size - 1];
+        }
+        
+        size_t size() const {
+            return m_size;
+        }
+        
+        bool empty() const {
+            return m_size == 0;
+        }
+        
+        size_t capacity() const {
+            return m_capacity;
+        }
+        
+        /**
+         Indicates whether the elements are stored inline, i.e., without a heap allocation.
+         */
+        bool isInline() const {
+            return m_elements == inlineElements();
+        }
+        
+        void reserve(const size_t capacity) {
+            if (capacity <= m_capacity)
+                return;
+            
+            T* elements = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            for (size_t i = 0; i < m_size; ++i) {
+                new (elements + i) T(std::move(m_elements[i]));
+                m_elements[i].~T();
+            }
+            deallocate();
+            m_elements = elements;
+            m_capacity = capacity;
+        }
+        
+        void clear() {
+            for (size_t i = 0; i < m_size; ++i)
+                m_elements[i].~T();
+            m_size = 0;
+        }
+        
+        template <typename... Args>
+        void emplace_back(Args&&... args) {
+            if (m_size == m_capacity) {
+                // the arguments may refer to an element of this vector, so construct the new
+                // element before growing the storage
+                T value(std::forward<Args>(args)...);
+                reserve(2 * m_capacity + 1);
+                new (m_elements + m_size) T(std::move(value));
+            } else {
+                new (m_elements + m_size) T(std::forward<Args>(args)...);
+            }
+            ++m_size;
+        }
+        
+        void push_back(T value) {
+            emplace_back(std::move(value));
+        }
+        
+        void pop_back() {
+            assert(m_size > 0);
+            m_elements[--m_size].~T();
+        }
+        
+        /**
+         Inserts the given value before the given position and returns an iterator to the
+         inserted element.
+         */
+        iterator insert(const_iterator position, T value) {
+            const size_t index = static_cast<size_t>(position - m_elements);
+            assert(index <= m_size);
+            
+            if (index == m_size) {
+                emplace_back(std::move(value));
+            } else {
+                emplace_back(std::move(back()));
+                std::move_backward(m_elements + index, m_elements + m_size - 2, m_elements + m_size - 1);
+                m_elements[index] = std::move(value);
+            }
+            return m_elements + index;
+        }
+        
+        iterator erase(const_iterator first, const_iterator last) {
+            const size_t index = static_cast<size_t>(first - m_elements);
+            const size_t count = static_cast<size_t>(last - first);
+            assert(index + count <= m_size);
+            
+            std::move(m_elements + index + count, m_elements + m_size, m_elements + index);
+            for (size_t i = m_size - count; i < m_size; ++i)
+                m_elements[i].~T();
+            m_size -= count;
+            return m_elements + index;
+        }
+        
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+    private:
+        T* inlineElements() {
+            return reinterpret_cast<T*>(m_inline);
+        }
+        
+        const T* inlineElements() const {
+            return reinterpret_cast<const T*>(m_inline);
+        }
+        
+        void deallocate() {
+            if (!isInline()) {
+                ::operator delete(m_elements);
+                m_elements = inlineElements();
+                m_capacity = N;
+            }
+        }
+        
+        void takeFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            assert(m_size == 0 && isInline());
+            if (other.isInline()) {
+                for (size_t i = 0; i < other.m_size; ++i)
+                    new (m_elements + i) T(std::move(other.m_elements[i]));
+                m_size = other.m_size;
+                other.clear();
+            } else {
+                m_elements = other.m_elements;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_elements = other.inlineElements();
+                other.m_size = 0;
+                other.m_capacity = N;
+            }
+        }
+    };
+    
+    /**
+     A set which stores its elements sorted in contiguous storage. Lookups are binary searches,
+     and insertions and removals move the subsequent elements, so this set is meant for sets with
+     few elements or sets which are mostly built once and then queried. Unlike std::set,
+     insertions and removals invalidate all iterators.
+     */
+    template <typename T, typename Compare = std::less<T>, size_t N = 4>
+    class FlatSet {
+    public:
+        typedef T value_type;
+        typedef T key_type;
+        typedef Compare key_compare;
+        typedef const T* iterator;
+        typedef const T* const_iterator;
+        typedef size_t size_type;
+    private:
+        SmallVector<T, N> m_elements;
+        Compare m_cmp;
+    public:
+        FlatSet() {}
+        
+        template <typename I>
+        FlatSet(I first, I last) {
+            insert(first, last);
+        }
+        
+        const_iterator begin() const { return m_elements.begin(); }
+        const_iterator end() const { return m_elements.end(); }
+        
+        size_t size() const {
+            return m_elements.size();
+        }
+        
+        bool empty() const {
+            return m_elements.empty();
+        }
+        
+        void clear() {
+            m_elements.clear();
+        }
+        
+        void reserve(const size_t capacity) {
+            m_elements.reserve(capacity);
+        }
+        
+        key_compare key_comp() const {
+            return m_cmp;
+        }
+        
+        const_iterator lower_bound(const T& value) const {
+            return std::lower_bound(begin(), end(), value, m_cmp);
+        }
+        
+        const_iterator upper_bound(const T& value) const {
+            return std::upper_bound(begin(), end(), value, m_cmp);
+        }
+        
+        const_iterator find(const T& value) const {
+            const_iterator it = lower_bound(value);
+            if (it != end() && !m_cmp(value, *it))
+                return it;
+            return end();
+        }
+        
+        size_t count(const T& value) const {
+            return find(value) != end() ? 1 : 0;
+        }
+        
+        std::pair<iterator, bool> insert(const T& value) {
+            const_iterator it = lower_bound(value);
+            if (it != end() && !m_cmp(value, *it))
+                return std::make_pair(it, false);
+            return std::make_pair(m_elements.insert(it, value), true);
+        }
+        
+        std::pair<iterator, bool> insert(T&& value) {
+            const_iterator it = lower_bound(value);
+            if (it != end() && !m_cmp(value, *it))
+                return std::make_pair(it, false);
+            return std::make_pair(m_elements.insert(it, std::move(value)), true);
+        }
+        
+        /**
+         Inserts the given range of values. The values are appended and the whole set is sorted
+         afterwards, which is faster than inserting them one by one.
+         */
+        template <typename I>
+        void insert(I first, I last) {
+            const size_t oldSize = m_elements.size();
+            while (first != last) {
+                m_elements.push_back(*first);
+                ++first;
+            }
+            if (m_elements.size() == oldSize)
+                return;
+            
+            std::sort(m_elements.begin() + oldSize, m_elements.end(), m_cmp);
+            std::inplace_merge(m_elements.begin(), m_elements.begin() + oldSize, m_elements.end(), m_cmp);
+            m_elements.erase(std::unique(m_elements.begin(), m_elements.end(), Equivalent(m_cmp)), m_elements.end());
+        }
+        
+        size_t erase(const T& value) {
+            const_iterator it = find(value);
+            if (it == end())
+                return 0;
+            m_elements.erase(it);
+            return 1;
+        }
+        
+        iterator erase(const_iterator position) {
+            return m_elements.erase(position);
+        }
+        
+        bool operator==(const FlatSet& other) const {
+            return size() == other.size() && std::equal(begin(), end(), other.begin(), Equivalent(m_cmp));
+        }
+        
+        bool operator!=(const FlatSet& other) const {
+            return !(*this == other);
+        }
+        
+        bool operator<(const FlatSet& other) const {
+            return std::lexicographical_compare(begin(), end(), other.begin(), other.end(), m_cmp);
+        }
+    private:
+        struct Equivalent {
+            Compare cmp;
+            
+            Equivalent(const Compare& i_cmp) :
+            cmp(i_cmp) {}
+            
+            bool operator()(const T& lhs, const T& rhs) const {
+                return !cmp(lhs, rhs) && !cmp(rhs, lhs);
+            }
+        };
+    };
+    
+    /**
+     A map which stores its entries sorted by key in contiguous storage. Like FlatSet, it is meant
+     for small maps, and insertions and removals invalidate all iterators.
+     */
+    template <typename K, typename V, typename Compare = std::less<K>, size_t N = 4>
+    class FlatMap {
+    public:
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<K, V> value_type;
+        typedef Compare key_compare;
+        typedef value_type* iterator;
+        typedef const value_type* const_iterator;
+        typedef size_t size_type;
+    private:
+        struct KeyLess {
+            Compare cmp;
+            
+            bool operator()(const value_type& lhs, const K& rhs) const {
+                return cmp(lhs.first, rhs);
+            }
+        };
+        
+        SmallVector<value_type, N> m_entries;
+        KeyLess m_less;
+    public:
+        iterator begin() { return m_entries.begin(); }
+        iterator end() { return m_entries.end(); }
+        const_iterator begin() const { return m_entries.begin(); }
+        const_iterator end() const { return m_entries.end(); }
+        
+        size_t size() const {
+            return m_entries.size();
+        }
+        
+        bool empty() const {
+            return m_entries.empty();
+        }
+        
+        void clear() {
+            m_entries.clear();
+        }
+        
+        void reserve(const size_t capacity) {
+            m_entries.reserve(capacity);
+        }
+        
+        iterator lower_bound(const K& key) {
+            return std::lower_bound(begin(), end(), key, m_less);
+        }
+        
+        const_iterator lower_bound(const K& key) const {
+            return std::lower_bound(begin(), end(), key, m_less);
+        }
+        
+        iterator find(const K& key) {
+            iterator it = lower_bound(key);
+            if (it != end() && !m_less.cmp(key, it->first))
+                return it;
+            return end();
+        }
+        
+        const_iterator find(const K& key) const {
+            const_iterator it = lower_bound(key);
+            if (it != end() && !m_less.cmp(key, it->first))
+                return it;
+            return end();
+        }
+        
+        size_t count(const K& key) const {
+            return find(key) != end() ? 1 : 0;
+        }
+        
+        std::pair<iterator, bool> insert(const value_type& entry) {
+            iterator it = lower_bound(entry.first);
+            if (it != end() && !m_less.cmp(entry.first, it->first))
+                return std::make_pair(it, false);
+            return std::make_pair(m_entries.insert(it, entry), true);
+        }
+        
+        V& operator[](const K& key) {
+            iterator it = lower_bound(key);
+            if (it == end() || m_less.cmp(key, it->first))
+                it = m_entries.insert(it, value_type(key, V()));
+            return it->second;
+        }
+        
+        size_t erase(const K& key) {
+            iterator it = find(key);
+            if (it == end())
+                return 0;
+            m_entries.erase(it);
+            return 1;
+        }
+        
+        iterator erase(const_iterator position) {
+            return m_entries.erase(position);
+        }
+    };
 }
 
 namespace CollectionUtils {
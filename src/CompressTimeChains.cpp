@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompressTimeChains.h"
+
+#include "StringUtils.h"
+
+#include <cassert>
+#include <utility>
+
+namespace Tippi {
+    CompressTimeChains::ChainState::ChainState(const BehaviorState* state) :
+    id(state->getId()),
+    netState(state->getNetState()) {}
+    
+    CompressTimeChains::CompressTimeChains(ChainMap* chains) :
+    m_chains(chains) {}
+    
+    Behavior::Ptr CompressTimeChains::operator()(Behavior::Ptr behavior) const {
+        // If no label "1" has ever been interned, the behavior has no time edges.
+        Label timeStep;
+        if (!Label::find("1", timeStep))
+            return behavior;
+        
+        // Collect the chains first because the state set must not change while it is traversed.
+        std::vector<ChainInfo> chains;
+        const Behavior::StateSet& states = behavior->getStates();
+        Behavior::StateSet::const_iterator sIt, sEnd;
+        for (sIt = states.begin(), sEnd = states.end(); sIt != sEnd; ++sIt) {
+            BehaviorState* source = *sIt;
+            if (isInnerState(behavior.get(), source, timeStep))
+                continue;
+            
+            BehaviorEdge* edge = findTimeEdge(source, timeStep);
+            if (edge == NULL || !isInnerState(behavior.get(), edge->getTarget(), timeStep))
+                continue;
+            
+            ChainInfo chain;
+            chain.source = source;
+            chain.target = edge->getTarget();
+            while (isInnerState(behavior.get(), chain.target, timeStep)) {
+                chain.innerStates.push_back(chain.target);
+                chain.target = chain.target->getOutgoing().front()->getTarget();
+            }
+            chains.push_back(chain);
+        }
+        
+        // Delete the inner states of all chains at once since every deletion sweeps the edges.
+        std::vector<BehaviorState*> innerStates;
+        std::vector<Chain> removed(m_chains != NULL ? chains.size() : 0);
+        for (size_t i = 0; i < chains.size(); ++i) {
+            const ChainInfo& chain = chains[i];
+            if (m_chains != NULL)
+                removed[i].assign(chain.innerStates.begin(), chain.innerStates.end());
+            innerStates.insert(innerStates.end(), chain.innerStates.begin(), chain.innerStates.end());
+        }
+        behavior->deleteStates(innerStates.begin(), innerStates.end());
+        
+        for (size_t i = 0; i < chains.size(); ++i) {
+            const ChainInfo& chain = chains[i];
+            
+            const String label = getDelayLabel(chain.innerStates.size() + 1);
+            const BehaviorEdge* edge = behavior->connectWithObservableEdge(chain.source, chain.target, label);
+            if (m_chains != NULL)
+                (*m_chains)[edge] = std::move(removed[i]);
+        }
+        
+        return behavior;
+    }
+    
+    String CompressTimeChains::getDelayLabel(const size_t delay) {
+        StringStream label;
+        label << "1^" << delay;
+        return label.str();
+    }
+    
+    bool CompressTimeChains::isInnerState(const Behavior* behavior, const BehaviorState* state, const Label& timeStep) const {
+        if (state == behavior->getInitialState() || state->isFinal() || state->isBoundViolation())
+            return false;
+        if (state->getIncoming().size() != 1 || state->getOutgoing().size() != 1)
+            return false;
+        
+        const BehaviorEdge* incoming = state->getIncoming().front();
+        const BehaviorEdge* outgoing = state->getOutgoing().front();
+        return (incoming->getLabel() == timeStep &&
+                outgoing->getLabel() == timeStep &&
+                outgoing->getTarget() != state);
+    }
+    
+    BehaviorEdge* CompressTimeChains::findTimeEdge(const BehaviorState* state, const Label& timeStep) const {
+        const BehaviorState::OutgoingList& edges = state->getOutgoing();
+        BehaviorState::OutgoingList::const_iterator it, end;
+        for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+            BehaviorEdge* edge = *it;
+            if (edge->getLabel() == timeStep)
+                return edge;
+        }
+        return NULL;
+    }
+}
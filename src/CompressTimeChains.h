@@ -0,0 +1,74 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__CompressTimeChains__
+#define __Tippi__CompressTimeChains__
+
+#include "Behavior.h"
+#include "IntervalNetState.h"
+
+#include <map>
+#include <vector>
+
+namespace Tippi {
+    /**
+     Collapses chains of time edges into single edges. A chain is a path of time edges whose inner
+     states have exactly one incoming and one outgoing edge, and which are neither initial nor final.
+     The inner states are removed and the chain is replaced by an edge from its first to its last
+     state that is labelled with the accumulated delay in the form "1^n", i.e., n time steps, so
+     that it cannot be mistaken for a transition or a single time step.
+     
+     If a chain map is given, it is filled with the removed inner states of each new edge, in the
+     order in which they occurred in the chain.
+     */
+    struct CompressTimeChains {
+    public:
+        struct ChainState {
+            size_t id;
+            Interval::NetState netState;
+            
+            ChainState(const BehaviorState* state);
+        };
+        
+        typedef std::vector<ChainState> Chain;
+        typedef std::map<const BehaviorEdge*, Chain> ChainMap;
+    private:
+        struct ChainInfo {
+            BehaviorState* source;
+            BehaviorState* target;
+            std::vector<BehaviorState*> innerStates;
+        };
+        
+        ChainMap* m_chains;
+    public:
+        CompressTimeChains(ChainMap* chains = NULL);
+        
+        Behavior::Ptr operator()(Behavior::Ptr behavior) const;
+        
+        /**
+         Returns the label of an edge that replaces a chain with the given accumulated delay.
+         */
+        static String getDelayLabel(size_t delay);
+    private:
+        bool isInnerState(const Behavior* behavior, const BehaviorState* state, const Label& timeStep) const;
+        BehaviorEdge* findTimeEdge(const BehaviorState* state, const Label& timeStep) const;
+    };
+}
+
+#endif /* defined(__Tippi__CompressTimeChains__) */
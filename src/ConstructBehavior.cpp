@@ -21,18 +21,25 @@
 
 #include "IntervalNetFiringRule.h"
 #include "IntervalNet.h"
+#include "IntervalNetStubbornSet.h"
 
 #include <cassert>
 
 namespace Tippi {
     ConstructBehavior::ConstructBehavior() :
-    m_createBoundViolationState(false) {}
+    m_createBoundViolationState(false),
+    m_usePartialOrderReduction(false),
+    m_timeStep("1") {}
 
     void ConstructBehavior::createBoundViolationState() {
         m_createBoundViolationState = true;
     }
 
-    Behavior::Ptr ConstructBehavior::operator()(const NetPtr net) const {
+    void ConstructBehavior::usePartialOrderReduction() {
+        m_usePartialOrderReduction = true;
+    }
+
+    Behavior::Ptr ConstructBehavior::operator()(const NetPtr& net) const {
         Behavior::Ptr behavior(new Behavior());
         
         const Interval::NetState initialState = Interval::NetState::createInitialState(*net);
@@ -40,31 +47,55 @@ namespace Tippi {
         behavior->setInitialState(behState);
 
         const Interval::FiringRule rule(*net);
-        handleState(net, rule, behState, behavior.get());
+        if (m_usePartialOrderReduction) {
+            const Interval::StubbornSet stubbornSet(*net);
+            handleState(net, rule, &stubbornSet, behState, behavior.get());
+        } else {
+            handleState(net, rule, NULL, behState, behavior.get());
+        }
         
         return behavior;
     }
 
-    void ConstructBehavior::handleState(const NetPtr net, const Interval::FiringRule& rule, BehaviorState* state, Behavior* behavior) const {
+    void ConstructBehavior::handleState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, BehaviorState* state, Behavior* behavior) const {
         assert(state != NULL);
         assert(behavior != NULL);
         
         const Interval::NetState& netState = state->getNetState();
         const Interval::Transition::List fireableTransitions = rule.getFireableTransitions(netState);
+        if (stubbornSet != NULL && handleReducedState(net, rule, stubbornSet, state, fireableTransitions, behavior))
+            return;
+        
         Interval::Transition::List::const_iterator it, end;
         for (it = fireableTransitions.begin(), end = fireableTransitions.end(); it != end; ++it) {
             Interval::Transition* transition = *it;
             const Interval::NetState succNetState = rule.fireTransition(transition, netState);
-            handleNetState(net, rule, state, succNetState, transition->getLabel(), behavior);
+            handleNetState(net, rule, stubbornSet, state, succNetState, transition->getLabel(), behavior);
         }
         
         if (rule.canMakeTimeStep(netState)) {
             const Interval::NetState succNetState = rule.makeTimeStep(netState);
-            handleNetState(net, rule, state, succNetState, "1", behavior);
+            handleNetState(net, rule, stubbornSet, state, succNetState, m_timeStep, behavior);
         }
     }
 
-    void ConstructBehavior::handleNetState(const NetPtr net, const Interval::FiringRule& rule, BehaviorState* state, const Interval::NetState& succNetState, const String& edgeLabel, Behavior* behavior) const {
+    bool ConstructBehavior::handleReducedState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, BehaviorState* state, const Interval::Transition::List& fireableTransitions, Behavior* behavior) const {
+        const Interval::NetState& netState = state->getNetState();
+        const Interval::Transition* transition = stubbornSet->findTransition(netState, fireableTransitions);
+        if (transition == NULL)
+            return false;
+        
+        // Only reduce if the successor is a new bounded state. Otherwise the state is fully expanded,
+        // which ensures that no transition is postponed forever along a cycle.
+        const Interval::NetState succNetState = rule.fireTransition(transition, netState);
+        if (!succNetState.isBounded(*net) || behavior->findState(succNetState) != NULL)
+            return false;
+        
+        handleNetState(net, rule, stubbornSet, state, succNetState, transition->getLabel(), behavior);
+        return true;
+    }
+
+    void ConstructBehavior::handleNetState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, BehaviorState* state, const Interval::NetState& succNetState, const Label& edgeLabel, Behavior* behavior) const {
 
         BehaviorState* succState = NULL;
         if (!succNetState.isBounded(*net)) {
@@ -79,7 +110,7 @@ namespace Tippi {
                     succState->setFinal(true);
                     behavior->addFinalState(succState);
                 }
-                handleState(net, rule, succState, behavior);
+                handleState(net, rule, stubbornSet, succState, behavior);
             }
         }
         
@@ -30,21 +30,32 @@ namespace Tippi {
         class FiringRule;
         class Net;
         class NetState;
+        class StubbornSet;
     }
     
     struct ConstructBehavior {
     private:
         bool m_createBoundViolationState;
+        bool m_usePartialOrderReduction;
+        Label m_timeStep;
     public:
-        typedef std::tr1::shared_ptr<Interval::Net> NetPtr;
+        typedef std::shared_ptr<Interval::Net> NetPtr;
 
         ConstructBehavior();
         void createBoundViolationState();
         
-        Behavior::Ptr operator()(const NetPtr net) const;
+        /**
+         Enables partial order reduction. If enabled, only one of several interleavings of
+         independent unobservable transitions is explored. The resulting behavior contains fewer
+         states, but it preserves deadlocks, bound violations and the reachability of final states.
+         */
+        void usePartialOrderReduction();
+        
+        Behavior::Ptr operator()(const NetPtr& net) const;
     private:
-        void handleState(const NetPtr net, const Interval::FiringRule& rule, Behavior::State* state, Behavior* behavior) const;
-        void handleNetState(const NetPtr net, const Interval::FiringRule& rule, BehaviorState* state, const Interval::NetState& succNetState, const String& edgeLabel, Behavior* behavior) const;
+        void handleState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, Behavior::State* state, Behavior* behavior) const;
+        bool handleReducedState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, Behavior::State* state, const Interval::Transition::List& fireableTransitions, Behavior* behavior) const;
+        void handleNetState(const NetPtr& net, const Interval::FiringRule& rule, const Interval::StubbornSet* stubbornSet, BehaviorState* state, const Interval::NetState& succNetState, const Label& edgeLabel, Behavior* behavior) const;
     };
 }
 
@@ -24,16 +24,23 @@
 #include "Exceptions.h"
 
 #include <cassert>
+#include <utility>
 
 namespace Tippi {
+    ConstructClosureAutomaton::Successor::Successor(const Label& i_label, const ClosureEdge::EdgeType i_type, Closure i_closure) :
+    label(i_label),
+    type(i_type),
+    closure(std::move(i_closure)) {}
+    
     ConstructClosureAutomaton::ConstructClosureAutomaton() :
-    m_useAnonymousStateNames(false) {}
+    m_useAnonymousStateNames(false),
+    m_timeStep("1") {}
     
     void ConstructClosureAutomaton::setUseAnonymousStateNames() {
         m_useAnonymousStateNames = true;
     }
     
-    ClosureAutomaton::Ptr ConstructClosureAutomaton::operator()(const NetPtr net) {
+    ClosureAutomaton::Ptr ConstructClosureAutomaton::operator()(const NetPtr& net) {
         updateTransitionTypes(net);
         
         ClosureAutomaton::Ptr automaton(new ClosureAutomaton());
@@ -41,7 +48,7 @@ namespace Tippi {
         return automaton;
     }
     
-    void ConstructClosureAutomaton::updateTransitionTypes(const NetPtr net) {
+    void ConstructClosureAutomaton::updateTransitionTypes(const NetPtr& net) {
         const Interval::Transition::List& transitions = net->getTransitions();
         m_transitionTypes = TransitionTypes(transitions.size(), TransitionType_Internal);
         
@@ -71,21 +78,19 @@ namespace Tippi {
         }
     }
     
-    void ConstructClosureAutomaton::buildAutomaton(const NetPtr net, ClosureAutomaton::Ptr automaton) const {
+    void ConstructClosureAutomaton::buildAutomaton(const NetPtr& net, const ClosureAutomaton::Ptr& automaton) const {
         Interval::FiringRule rule(*net);
         const Interval::NetState initialNetState = Interval::NetState::createInitialState(*net);
         
-        const Interval::FiringRule::Closure initialClosure = rule.buildClosure(initialNetState);
-
-        ClosureState* initialState = automaton->createState(initialClosure);
+        ClosureState* initialState = automaton->createState(rule.buildClosure(initialNetState));
         automaton->setInitialState(initialState);
         handleState(net, rule, initialState, automaton);
     }
     
-    void ConstructClosureAutomaton::handleState(const NetPtr net,
+    void ConstructClosureAutomaton::handleState(const NetPtr& net,
                                                 const Interval::FiringRule& rule,
                                                 ClosureState* state,
-                                                ClosureAutomaton::Ptr automaton) const {
+                                                const ClosureAutomaton::Ptr& automaton) const {
         
         const Closure& closure = state->getClosure();
         
@@ -95,14 +100,14 @@ namespace Tippi {
             const Interval::Transition* transition = *it;
             if (m_transitionTypes[transition->getIndex()] != TransitionType_Internal) {
                 const Interval::NetState::Set successors = getSuccessorsForObservableTransition(net, rule, closure.getStates(), transition);
-                const String& label = transition->getLabel();
+                const Label& label = transition->getLabel();
                 const ClosureEdge::EdgeType type = getEdgeType(transition);
                 handleSuccessors(net, rule, state, successors, label, type, automaton);
             }
         }
         
         const Interval::NetState::Set successors = getSuccessorsForTimeStep(net, rule, closure.getStates());
-        handleSuccessors(net, rule, state, successors, "1", ClosureEdge::EdgeType_Time, automaton);
+        handleSuccessors(net, rule, state, successors, m_timeStep, ClosureEdge::EdgeType_Time, automaton);
     }
     
     ClosureEdge::EdgeType ConstructClosureAutomaton::getEdgeType(const Interval::Transition* transition) const {
@@ -120,26 +125,26 @@ namespace Tippi {
         }
     }
     
-    void ConstructClosureAutomaton::handleSuccessors(const NetPtr net,
+    void ConstructClosureAutomaton::handleSuccessors(const NetPtr& net,
                                                      const Interval::FiringRule& rule,
                                                      ClosureState* state,
                                                      const Interval::NetState::Set& successors,
-                                                     const String& label,
+                                                     const Label& label,
                                                      const ClosureEdge::EdgeType type,
-                                                     ClosureAutomaton::Ptr automaton) const {
+                                                     const ClosureAutomaton::Ptr& automaton) const {
         typedef std::pair<ClosureState*, bool> ClosureStateResult;
         
-        const Closure succClosure = rule.buildClosure(successors);
+        Closure succClosure = rule.buildClosure(successors);
         if (succClosure.containsBoundViolation()) {
-            ClosureState* succState = automaton->boundViolationState(succClosure);
+            ClosureState* succState = automaton->boundViolationState(std::move(succClosure));
             automaton->connectWithObservableEdge(state, succState, label, type);
         } else {
-            const ClosureStateResult succStateResult = automaton->findOrCreateState(succClosure);
+            const ClosureStateResult succStateResult = automaton->findOrCreateState(std::move(succClosure));
             ClosureState* succState = succStateResult.first;
             automaton->connectWithObservableEdge(state, succState, label, type);
 
             if (succStateResult.second) {
-                if (isFinalState(net, succState)) {
+                if (isFinalState(net, succState->getClosure())) {
                     succState->setFinal(true);
                     automaton->addFinalState(succState);
                 }
@@ -149,9 +154,27 @@ namespace Tippi {
         
     }
     
-    bool ConstructClosureAutomaton::isFinalState(const NetPtr net, const ClosureState* state) const {
+    void ConstructClosureAutomaton::buildSuccessors(const NetPtr& net,
+                                                    const Interval::FiringRule& rule,
+                                                    const Closure& closure,
+                                                    SuccessorList& result) const {
+        const Interval::Transition::List& transitions = net->getTransitions();
+        Interval::Transition::List::const_iterator it, end;
+        for (it = transitions.begin(), end = transitions.end(); it != end; ++it) {
+            const Interval::Transition* transition = *it;
+            if (m_transitionTypes[transition->getIndex()] != TransitionType_Internal) {
+                const Interval::NetState::Set successors = getSuccessorsForObservableTransition(net, rule, closure.getStates(), transition);
+                result.push_back(Successor(transition->getLabel(), getEdgeType(transition), rule.buildClosure(successors)));
+            }
+        }
+        
+        const Interval::NetState::Set successors = getSuccessorsForTimeStep(net, rule, closure.getStates());
+        result.push_back(Successor(m_timeStep, ClosureEdge::EdgeType_Time, rule.buildClosure(successors)));
+    }
+    
+    bool ConstructClosureAutomaton::isFinalState(const NetPtr& net, const Closure& closure) const {
         const Marking::List& finalMarkings = net->getFinalMarkings();
-        const Interval::NetState::Set& states = state->getClosure().getStates();
+        const Interval::NetState::Set& states = closure.getStates();
         
         Marking::List::const_iterator mIt = finalMarkings.begin();
         const Marking::List::const_iterator mEnd = finalMarkings.end();
@@ -172,18 +195,21 @@ namespace Tippi {
         return false;
     }
     
-    Interval::NetState::Set ConstructClosureAutomaton::getSuccessorsForObservableTransition(const NetPtr net,
+    Interval::NetState::Set ConstructClosureAutomaton::getSuccessorsForObservableTransition(const NetPtr& net,
                                                                                             const Interval::FiringRule& rule,
                                                                                             const Interval::NetState::Set& states,
                                                                                             const Interval::Transition* transition) const {
         
         Interval::NetState::Set successors;
+        if (states.empty())
+            return successors;
         
+        Interval::NetState successor(*states.begin());
         Interval::NetState::Set::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
             const Interval::NetState& state = *it;
             if (rule.isFireable(transition, state)) {
-                const Interval::NetState successor = rule.fireTransition(transition, state);
+                rule.fireTransition(transition, state, successor);
                 successors.insert(successor);
             }
         }
@@ -191,16 +217,19 @@ namespace Tippi {
         return successors;
     }
     
-    Interval::NetState::Set ConstructClosureAutomaton::getSuccessorsForTimeStep(const NetPtr net,
+    Interval::NetState::Set ConstructClosureAutomaton::getSuccessorsForTimeStep(const NetPtr& net,
                                                                                 const Interval::FiringRule& rule,
                                                                                 const Interval::NetState::Set& states) const {
         Interval::NetState::Set successors;
+        if (states.empty())
+            return successors;
         
+        Interval::NetState successor(*states.begin());
         Interval::NetState::Set::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
             const Interval::NetState& state = *it;
             if (rule.canMakeTimeStep(state)) {
-                const Interval::NetState successor = rule.makeTimeStep(state);
+                rule.makeTimeStep(state, successor);
                 successors.insert(successor);
             }
         }
@@ -27,6 +27,7 @@
 #include "IntervalNetState.h"
 
 #include <iostream>
+#include <vector>
 
 namespace Tippi {
     namespace Interval {
@@ -45,43 +46,72 @@ namespace Tippi {
         } TransitionType;
         
         bool m_useAnonymousStateNames;
+        Label m_timeStep;
         
         typedef std::vector<TransitionType> TransitionTypes;
         TransitionTypes m_transitionTypes;
     public:
-        typedef std::tr1::shared_ptr<Interval::Net> NetPtr;
+        typedef std::shared_ptr<Interval::Net> NetPtr;
+        
+        /**
+         A successor of a closure along with the label and type of the edge leading to it.
+         */
+        struct Successor {
+            Label label;
+            ClosureEdge::EdgeType type;
+            Closure closure;
+            
+            Successor(const Label& i_label, ClosureEdge::EdgeType i_type, Closure i_closure);
+        };
+        typedef std::vector<Successor> SuccessorList;
         
         ConstructClosureAutomaton();
         void setUseAnonymousStateNames();
-        ClosureAutomaton::Ptr operator()(const NetPtr net);
-    private:
-        void updateTransitionTypes(const NetPtr net);
+        ClosureAutomaton::Ptr operator()(const NetPtr& net);
+        
+        /**
+         Determines the interface type of each transition of the given net. Must be called before
+         the successors of a closure of that net are computed by buildSuccessors.
+         
+         @throws ClosureException if a transition is connected to more than one interface place
+         */
+        void updateTransitionTypes(const NetPtr& net);
         
-        void buildAutomaton(const NetPtr net, ClosureAutomaton::Ptr automaton) const;
+        /**
+         Computes the successors of the given closure, first for each interface transition in the
+         order of the transitions of the net and then for a time step. The successors are appended
+         to the given list in the same order in which the closure automaton connects them.
+         */
+        void buildSuccessors(const NetPtr& net,
+                             const Interval::FiringRule& rule,
+                             const Closure& closure,
+                             SuccessorList& result) const;
         
-        void handleState(const NetPtr net,
+        bool isFinalState(const NetPtr& net, const Closure& closure) const;
+    private:
+        void buildAutomaton(const NetPtr& net, const ClosureAutomaton::Ptr& automaton) const;
+        
+        void handleState(const NetPtr& net,
                          const Interval::FiringRule& rule,
                          ClosureState* state,
-                         ClosureAutomaton::Ptr automaton) const;
+                         const ClosureAutomaton::Ptr& automaton) const;
         
         ClosureEdge::EdgeType getEdgeType(const Interval::Transition* transition) const;
         
-        void handleSuccessors(const NetPtr net,
+        void handleSuccessors(const NetPtr& net,
                               const Interval::FiringRule& rule,
                               ClosureState* state,
                               const Interval::NetState::Set& successors,
-                              const String& label,
+                              const Label& label,
                               ClosureEdge::EdgeType type,
-                              ClosureAutomaton::Ptr automaton) const;
-        
-        bool isFinalState(const NetPtr net, const ClosureState* state) const;
+                              const ClosureAutomaton::Ptr& automaton) const;
         
-        Interval::NetState::Set getSuccessorsForObservableTransition(const NetPtr net,
+        Interval::NetState::Set getSuccessorsForObservableTransition(const NetPtr& net,
                                                                      const Interval::FiringRule& rule,
                                                                      const Interval::NetState::Set& states,
                                                                      const Interval::Transition* transition) const;
         
-        Interval::NetState::Set getSuccessorsForTimeStep(const NetPtr net,
+        Interval::NetState::Set getSuccessorsForTimeStep(const NetPtr& net,
                                                          const Interval::FiringRule& rule,
                                                          const Interval::NetState::Set& states) const;
     };
@@ -30,7 +30,7 @@ namespace Tippi {
     }
     
     struct ConstructMaximalNet {
-        typedef std::tr1::shared_ptr<Interval::Net> NetPtr;
+        typedef std::shared_ptr<Interval::Net> NetPtr;
         NetPtr operator()(NetPtr net) const;
     };
 }
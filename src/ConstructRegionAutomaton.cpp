@@ -19,94 +19,314 @@
 
 #include "ConstructRegionAutomaton.h"
 
+#include "ConstructClosureAutomaton.h"
+#include "Exceptions.h"
+#include "IntervalNetFiringRule.h"
+#include "IntervalNetState.h"
+
+#include <algorithm>
+#include <limits>
+
 namespace Tippi {
+    ConstructRegionAutomaton::RegionInfo::RegionInfo() :
+    fingerprint(std::numeric_limits<Fingerprint>::max()),
+    closureCount(0),
+    final(false) {}
+    
+    void ConstructRegionAutomaton::RegionInfo::merge(const RegionInfo& other) {
+        fingerprint = std::min(fingerprint, other.fingerprint);
+        closureCount += other.closureCount;
+        final |= other.final;
+    }
+    
+    ConstructRegionAutomaton::PartnerEdge::PartnerEdge(const size_t i_source, const Label& i_label, const Fingerprint i_target) :
+    source(i_source),
+    label(i_label),
+    target(i_target) {}
+    
     RegionAutomaton::Ptr ConstructRegionAutomaton::operator()(const ClosureAutomaton::Ptr closureAutomaton) {
         RegionAutomaton::Ptr regionAutomaton(new RegionAutomaton());
         
-        const ClosureAutomaton::StateSet& clStates = closureAutomaton->getStates();
-        ClosureState::resetVisited(clStates.begin(), clStates.end());
-        
         ClosureState* initialCl = closureAutomaton->getInitialState();
-        if (initialCl != NULL)
-            buildRegion(initialCl, regionAutomaton);
+        if (initialCl == NULL)
+            return regionAutomaton;
+        assert(!initialCl->isEmpty());
+        
+        computeRegions(*closureAutomaton);
+        collectMembers(*closureAutomaton);
+        
+        RegionList queue;
+        queue.push_back(buildRegion(initialCl, regionAutomaton));
+        regionAutomaton->setInitialState(queue.front());
+        for (size_t i = 0; i < queue.size(); ++i)
+            buildSuccessors(queue[i], regionAutomaton, queue);
         
+        m_regionOf.clear();
+        m_offsets.clear();
+        m_members.clear();
         return regionAutomaton;
     }
     
-    RegionState* ConstructRegionAutomaton::buildRegion(ClosureState* state, RegionAutomaton::Ptr automaton) const {
+    void ConstructRegionAutomaton::computeRegions(const ClosureAutomaton& closureAutomaton) {
+        const size_t stateCount = closureAutomaton.getMaxId() + 1;
+        UnionFind regions(stateCount);
+        
+        const ClosureAutomaton::EdgeSet& edges = closureAutomaton.getEdges();
+        ClosureAutomaton::EdgeSet::const_iterator eIt, eEnd;
+        for (eIt = edges.begin(), eEnd = edges.end(); eIt != eEnd; ++eIt) {
+            const ClosureEdge* edge = *eIt;
+            if (edge->isServiceAction() || edge->isTimeAction()) {
+                const ClosureState* source = edge->getSource();
+                const ClosureState* target = edge->getTarget();
+                if (!source->isEmpty() && !target->isEmpty())
+                    regions.unite(source->getId(), target->getId());
+            }
+        }
+        
+        m_regionOf.assign(stateCount, stateCount);
+        const ClosureAutomaton::StateSet& states = closureAutomaton.getStates();
+        ClosureAutomaton::StateSet::const_iterator sIt, sEnd;
+        for (sIt = states.begin(), sEnd = states.end(); sIt != sEnd; ++sIt) {
+            const ClosureState* state = *sIt;
+            if (!state->isEmpty())
+                m_regionOf[state->getId()] = regions.find(state->getId());
+        }
+    }
+    
+    void ConstructRegionAutomaton::collectMembers(const ClosureAutomaton& closureAutomaton) {
+        const size_t stateCount = m_regionOf.size();
+        const ClosureAutomaton::StateSet& states = closureAutomaton.getStates();
+        ClosureAutomaton::StateSet::const_iterator it, end;
+        
+        m_offsets.assign(stateCount + 1, 0);
+        for (it = states.begin(), end = states.end(); it != end; ++it) {
+            const size_t region = m_regionOf[(*it)->getId()];
+            if (region < stateCount)
+                ++m_offsets[region + 1];
+        }
+        for (size_t i = 0; i < stateCount; ++i)
+            m_offsets[i + 1] += m_offsets[i];
+        
+        IndexList next(m_offsets.begin(), m_offsets.end() - 1);
+        m_members.resize(m_offsets.back());
+        for (it = states.begin(), end = states.end(); it != end; ++it) {
+            ClosureState* state = *it;
+            const size_t region = m_regionOf[state->getId()];
+            if (region < stateCount)
+                m_members[next[region]++] = state;
+        }
+    }
+    
+    RegionState* ConstructRegionAutomaton::buildRegion(const ClosureState* state, RegionAutomaton::Ptr automaton) const {
         assert(state != NULL);
         assert(!state->isEmpty());
-        if (state->isVisited()) {
-            RegionState* regionState = automaton->findRegion(state);
-            assert(regionState != NULL);
-            return regionState;
-        }
         
-        ClosureAutomaton::StateSet region;
-        growRegion(state, region);
+        const size_t index = m_regionOf[state->getId()];
+        const ClosureAutomaton::StateSet region(m_members.begin() + static_cast<long>(m_offsets[index]),
+                                                m_members.begin() + static_cast<long>(m_offsets[index + 1]));
         RegionState* regionState = automaton->createState(region);
-        buildSuccessors(regionState, automaton);
+        
+        ClosureAutomaton::StateSet::const_iterator it, end;
+        for (it = region.begin(), end = region.end(); it != end; ++it) {
+            const ClosureState* clState = *it;
+            if (clState->isFinal()) {
+                regionState->setFinal(true);
+                automaton->addFinalState(regionState);
+                break;
+            }
+        }
         return regionState;
     }
     
-    void ConstructRegionAutomaton::buildSuccessors(RegionState* region, RegionAutomaton::Ptr automaton) const {
+    void ConstructRegionAutomaton::buildSuccessors(RegionState* region, RegionAutomaton::Ptr automaton, RegionList& queue) const {
         const ClosureAutomaton::StateSet& clStates = region->getRegion();
-        ClosureAutomaton::StateSet::const_iterator it, end;
-        for (it = clStates.begin(), end = clStates.end(); it != end; ++it) {
-            ClosureState* clState = *it;
-            buildSuccessors(region, clState, automaton);
-        }
-    }
-
-    void ConstructRegionAutomaton::buildSuccessors(RegionState* region, ClosureState* state, RegionAutomaton::Ptr automaton) const {
-        const ClosureEdge::List& outgoing = state->getOutgoing();
-        ClosureEdge::List::const_iterator it, end;
-        for (it = outgoing.begin(), end = outgoing.end(); it != end; ++it) {
-            ClosureEdge* edge = *it;
-            if (edge->isPartnerAction()) {
-                ClosureState* target = edge->getTarget();
-                if (!target->isEmpty()) {
-                    RegionState* succRegion = buildRegion(target, automaton);
-                    automaton->connectWithObservableEdge(region, succRegion, edge->getLabel());
+        ClosureAutomaton::StateSet::const_iterator sIt, sEnd;
+        for (sIt = clStates.begin(), sEnd = clStates.end(); sIt != sEnd; ++sIt) {
+            const ClosureState* clState = *sIt;
+            
+            const ClosureEdge::List& outgoing = clState->getOutgoing();
+            ClosureEdge::List::const_iterator eIt, eEnd;
+            for (eIt = outgoing.begin(), eEnd = outgoing.end(); eIt != eEnd; ++eIt) {
+                const ClosureEdge* edge = *eIt;
+                if (edge->isPartnerAction()) {
+                    const ClosureState* target = edge->getTarget();
+                    if (!target->isEmpty()) {
+                        RegionState* succRegion = automaton->findRegion(target);
+                        if (succRegion == NULL) {
+                            succRegion = buildRegion(target, automaton);
+                            queue.push_back(succRegion);
+                        }
+                        automaton->connectWithObservableEdge(region, succRegion, edge->getLabel());
+                    }
                 }
             }
         }
     }
-
-    void ConstructRegionAutomaton::growRegion(ClosureState* state, ClosureAutomaton::StateSet& region) const {
-        if (!state->isVisited() && !state->isEmpty()) {
-            region.insert(state);
-            state->setVisited(true);
-            
-            const ClosureEdge::List& incoming = state->getIncoming();
-            const ClosureEdge::List& outgoing = state->getOutgoing();
+    
+    RegionAutomaton::Ptr ConstructRegionAutomaton::operator()(const NetPtr& net) {
+        ConstructClosureAutomaton closures;
+        closures.updateTransitionTypes(net);
+        const Interval::FiringRule rule(*net);
+        
+        Closure initial = rule.buildClosure(Interval::NetState::createInitialState(*net));
+        assert(!initial.isEmpty());
+        
+        FingerprintQueue entries;
+        entries.push_back(RegionState::fingerprint(initial));
+        m_entryClosures.insert(std::make_pair(entries.front(), std::move(initial)));
+        
+        while (!entries.empty()) {
+            const Fingerprint entry = entries.front();
+            entries.pop_front();
             
-            growIncoming(incoming, region);
-            growOutgoing(outgoing, region);
+            // the entry may have been added to a region since it was queued
+            if (m_regionOfClosure.count(entry) == 0)
+                exploreRegion(net, rule, closures, entry, entries);
         }
+        
+        RegionAutomaton::Ptr regionAutomaton = buildRegionAutomaton();
+        
+        m_regionSets = UnionFind();
+        m_regionInfos.clear();
+        m_regionOfClosure.clear();
+        m_partnerEdges.clear();
+        m_entryClosures.clear();
+        return regionAutomaton;
     }
     
-    void ConstructRegionAutomaton::growIncoming(const ClosureEdge::List& incoming, ClosureAutomaton::StateSet& region) const {
-        ClosureEdge::List::const_iterator it, end;
-        for (it = incoming.begin(), end = incoming.end(); it != end; ++it) {
-            ClosureEdge* edge = *it;
-            if (edge->isServiceAction() || edge->isTimeAction()) {
-                ClosureState* source = edge->getSource();
-                growRegion(source, region);
+    void ConstructRegionAutomaton::exploreRegion(const NetPtr& net,
+                                                 const Interval::FiringRule& rule,
+                                                 const ConstructClosureAutomaton& closures,
+                                                 const Fingerprint entry,
+                                                 FingerprintQueue& entries) {
+        const size_t region = m_regionSets.add();
+        m_regionInfos.push_back(RegionInfo());
+        
+        ClosureStack stack;
+        const ClosureMap::const_iterator entryIt = m_entryClosures.find(entry);
+        assert(entryIt != m_entryClosures.end());
+        addToRegion(region, entry, entryIt->second, net, closures, stack);
+        
+        TargetList targets;
+        ConstructClosureAutomaton::SuccessorList successors;
+        while (!stack.empty()) {
+            const Closure& closure = *stack.back();
+            stack.pop_back();
+            
+            // the bound violation state has no successors
+            if (closure.containsBoundViolation())
+                continue;
+            
+            successors.clear();
+            closures.buildSuccessors(net, rule, closure, successors);
+            
+            ConstructClosureAutomaton::SuccessorList::iterator it, end;
+            for (it = successors.begin(), end = successors.end(); it != end; ++it) {
+                ConstructClosureAutomaton::Successor& successor = *it;
+                if (successor.closure.isEmpty())
+                    continue;
+                
+                const Fingerprint fingerprint = RegionState::fingerprint(successor.closure);
+                if (ClosureEdge::isPartnerAction(successor.type)) {
+                    m_partnerEdges.push_back(PartnerEdge(region, successor.label, fingerprint));
+                    targets.push_back(std::make_pair(fingerprint, std::move(successor.closure)));
+                } else {
+                    const FingerprintMap::const_iterator regionIt = m_regionOfClosure.find(fingerprint);
+                    if (regionIt == m_regionOfClosure.end()) {
+                        addToRegion(region, fingerprint, std::move(successor.closure), net, closures, stack);
+                    } else {
+                        checkCollision(fingerprint, successor.closure);
+                        m_regionSets.unite(region, regionIt->second);
+                    }
+                }
+            }
+        }
+        
+        // the region is complete, so only the targets of its partner edges that do not belong to
+        // any region or the entry queue yet must be kept
+        TargetList::iterator it, end;
+        for (it = targets.begin(), end = targets.end(); it != end; ++it) {
+            const Fingerprint fingerprint = it->first;
+            checkCollision(fingerprint, it->second);
+            if (m_regionOfClosure.count(fingerprint) == 0 && m_entryClosures.count(fingerprint) == 0) {
+                m_entryClosures.insert(std::make_pair(fingerprint, std::move(it->second)));
+                entries.push_back(fingerprint);
             }
         }
+        m_openClosures.clear();
     }
     
-    void ConstructRegionAutomaton::growOutgoing(const ClosureEdge::List& outgoing, ClosureAutomaton::StateSet& region) const {
-        typedef std::pair<SuccessorMap::iterator, bool> InsertPos;
+    void ConstructRegionAutomaton::addToRegion(const size_t region,
+                                               const Fingerprint fingerprint,
+                                               Closure closure,
+                                               const NetPtr& net,
+                                               const ConstructClosureAutomaton& closures,
+                                               ClosureStack& stack) {
+        checkCollision(fingerprint, closure);
+        m_regionOfClosure.insert(std::make_pair(fingerprint, region));
         
-        ClosureEdge::List::const_iterator it, end;
-        for (it = outgoing.begin(), end = outgoing.end(); it != end; ++it) {
-            ClosureEdge* edge = *it;
-            if (edge->isServiceAction() || edge->isTimeAction()) {
-                ClosureState* target = edge->getTarget();
-                growRegion(target, region);
+        RegionInfo& info = m_regionInfos[region];
+        info.fingerprint = std::min(info.fingerprint, fingerprint);
+        ++info.closureCount;
+        if (!closure.containsBoundViolation() && closures.isFinalState(net, closure))
+            info.final = true;
+        
+        // the elements of an unordered map are not moved when it grows
+        const ClosureMap::iterator it = m_openClosures.insert(std::make_pair(fingerprint, std::move(closure))).first;
+        stack.push_back(&it->second);
+    }
+    
+    void ConstructRegionAutomaton::checkCollision(const Fingerprint fingerprint, const Closure& closure) const {
+        ClosureMap::const_iterator it = m_openClosures.find(fingerprint);
+        if (it == m_openClosures.end()) {
+            it = m_entryClosures.find(fingerprint);
+            if (it == m_entryClosures.end())
+                return;
+        }
+        // all closures which contain a bound violation have the same fingerprint on purpose
+        if (closure.containsBoundViolation() && it->second.containsBoundViolation())
+            return;
+        if (it->second != closure)
+            throw ClosureException() << "Two different closures have the same fingerprint " << fingerprint << ", construct the region automaton from the closure automaton instead";
+    }
+    
+    RegionAutomaton::Ptr ConstructRegionAutomaton::buildRegionAutomaton() {
+        RegionAutomaton::Ptr automaton(new RegionAutomaton());
+        
+        const size_t regionCount = m_regionSets.size();
+        for (size_t i = 0; i < regionCount; ++i) {
+            const size_t root = m_regionSets.find(i);
+            if (root != i)
+                m_regionInfos[root].merge(m_regionInfos[i]);
+        }
+        
+        RegionList regions(regionCount, NULL);
+        for (size_t i = 0; i < regionCount; ++i) {
+            if (m_regionSets.find(i) == i) {
+                const RegionInfo& info = m_regionInfos[i];
+                RegionState* region = automaton->createState(info.fingerprint, info.closureCount);
+                if (info.final) {
+                    region->setFinal(true);
+                    automaton->addFinalState(region);
+                }
+                regions[i] = region;
             }
         }
+        
+        if (regionCount > 0)
+            automaton->setInitialState(regions[m_regionSets.find(0)]);
+        
+        PartnerEdgeList::const_iterator it, end;
+        for (it = m_partnerEdges.begin(), end = m_partnerEdges.end(); it != end; ++it) {
+            const PartnerEdge& edge = *it;
+            const FingerprintMap::const_iterator targetIt = m_regionOfClosure.find(edge.target);
+            assert(targetIt != m_regionOfClosure.end());
+            
+            RegionState* source = regions[m_regionSets.find(edge.source)];
+            RegionState* target = regions[m_regionSets.find(targetIt->second)];
+            automaton->connectWithObservableEdge(source, target, edge.label);
+        }
+        
+        return automaton;
     }
 }
@@ -23,30 +23,132 @@
 #include "SharedPointer.h"
 #include "Closure.h"
 #include "Region.h"
+#include "UnionFind.h"
 
-#include <iostream>
-#include <map>
-
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Tippi {
-    class ReAutomaton;
+    namespace Interval {
+        class FiringRule;
+        class Net;
+    }
+    
+    struct ConstructClosureAutomaton;
     class RegionState;
     
+    /**
+     Partitions the non-empty states of a closure automaton into regions, which are the connected
+     components with respect to service and time edges, and connects the regions by the partner
+     edges between their states. Only the regions reachable from the region of the initial state
+     are constructed.
+     
+     The regions are computed in a single pass over the edges using a union-find structure, and
+     the region automaton is built by a breadth first search over the regions, so the size of the
+     closure automaton is not limited by the depth of the call stack.
+     
+     Alternatively, the region automaton can be built directly from a net without building its
+     closure automaton first. Then the closures are explored region by region, and the closures of
+     a region are discarded as soon as the region is complete. Only a 64 bit fingerprint of each
+     closure is kept to find the region that contains it, so the resulting regions do not store
+     their closure states. Since a closure may be connected by service or time edges to a region
+     which is already complete, regions are merged using a union-find structure.
+     
+     Two different closures may have the same fingerprint. To detect this, the closures of the
+     region that is currently explored and the entry closures of all regions, i.e., the targets of
+     partner edges, are kept, and every closure whose fingerprint matches one of them is compared
+     to it. A detected collision raises a ClosureException. A collision with a closure of a
+     completed region which is not an entry closure cannot be detected, and would merge the two
+     regions, but with 64 bit fingerprints, this is very unlikely.
+     */
     struct ConstructRegionAutomaton {
     private:
-        typedef std::map<RegionState*, String> SuccessorMap;
-        typedef std::map<ClosureState*, RegionState*> StateRegionMap;
+        typedef std::vector<size_t> IndexList;
+        typedef std::vector<ClosureState*> StateList;
+        typedef std::vector<RegionState*> RegionList;
+        
+        /**
+         Maps the id of each closure state to the id of the representative state of its region.
+         Empty states are not contained in any region.
+         */
+        IndexList m_regionOf;
+        
+        /**
+         The members of each region, grouped by region. The members of the region represented by
+         the state with id i are stored in m_members[m_offsets[i]] to m_members[m_offsets[i + 1]].
+         */
+        IndexList m_offsets;
+        StateList m_members;
+        
+        typedef RegionState::Fingerprint Fingerprint;
+        typedef std::vector<const Closure*> ClosureStack;
+        typedef std::deque<Fingerprint> FingerprintQueue;
+        typedef std::vector<std::pair<Fingerprint, Closure> > TargetList;
+        typedef std::unordered_map<Fingerprint, size_t> FingerprintMap;
+        typedef std::unordered_map<Fingerprint, Closure> ClosureMap;
         
-        StateRegionMap m_regions;
+        struct RegionInfo {
+            Fingerprint fingerprint;
+            size_t closureCount;
+            bool final;
+            
+            RegionInfo();
+            void merge(const RegionInfo& other);
+        };
+        typedef std::vector<RegionInfo> RegionInfoList;
+        
+        struct PartnerEdge {
+            size_t source;
+            Label label;
+            Fingerprint target;
+            
+            PartnerEdge(size_t i_source, const Label& i_label, Fingerprint i_target);
+        };
+        typedef std::vector<PartnerEdge> PartnerEdgeList;
+        
+        /**
+         The regions built from a net so far. Each closure fingerprint is mapped to the index of
+         the region to which the closure was first added. Regions which turned out to be connected
+         are merged in m_regionSets.
+         */
+        UnionFind m_regionSets;
+        RegionInfoList m_regionInfos;
+        FingerprintMap m_regionOfClosure;
+        PartnerEdgeList m_partnerEdges;
+        
+        /**
+         The entry closures of all regions, including the ones which have not been explored yet,
+         and the closures of the region which is currently explored. These are kept to check
+         fingerprint matches for collisions.
+         */
+        ClosureMap m_entryClosures;
+        ClosureMap m_openClosures;
     public:
+        typedef std::shared_ptr<Interval::Net> NetPtr;
+        
         RegionAutomaton::Ptr operator()(const ClosureAutomaton::Ptr closureAutomaton);
+        RegionAutomaton::Ptr operator()(const NetPtr& net);
     private:
-        RegionState* buildRegion(ClosureState* state, RegionAutomaton::Ptr automaton) const;
-        void buildSuccessors(RegionState* region, RegionAutomaton::Ptr automaton) const;
-        void buildSuccessors(RegionState* region, ClosureState* state, RegionAutomaton::Ptr automaton) const;
-        void growRegion(ClosureState* state, ClosureAutomaton::StateSet& region) const;
-        void growIncoming(const ClosureEdge::List& incoming, ClosureAutomaton::StateSet& region) const;
-        void growOutgoing(const ClosureEdge::List& outgoing, ClosureAutomaton::StateSet& region) const;
+        void computeRegions(const ClosureAutomaton& closureAutomaton);
+        void collectMembers(const ClosureAutomaton& closureAutomaton);
+        RegionState* buildRegion(const ClosureState* state, RegionAutomaton::Ptr automaton) const;
+        void buildSuccessors(RegionState* region, RegionAutomaton::Ptr automaton, RegionList& queue) const;
+        
+        void exploreRegion(const NetPtr& net,
+                           const Interval::FiringRule& rule,
+                           const ConstructClosureAutomaton& closures,
+                           Fingerprint entry,
+                           FingerprintQueue& entries);
+        void addToRegion(size_t region,
+                         Fingerprint fingerprint,
+                         Closure closure,
+                         const NetPtr& net,
+                         const ConstructClosureAutomaton& closures,
+                         ClosureStack& stack);
+        void checkCollision(Fingerprint fingerprint, const Closure& closure) const;
+        RegionAutomaton::Ptr buildRegionAutomaton();
     };
 }
 
@@ -0,0 +1,216 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DeterminizeAutomaton.h"
+
+#include "Bisimulation.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Tippi {
+    DeterminizeAutomaton::SubsetIndex::SubsetIndex() {
+        m_offsets.push_back(0);
+    }
+    
+    size_t DeterminizeAutomaton::SubsetIndex::getIndex(const IndexList& subset, bool& added) {
+        if (2 * (size() + 1) > m_buckets.size())
+            grow();
+        
+        const size_t h = hash(subset);
+        const size_t mask = m_buckets.size() - 1;
+        size_t bucket = h & mask;
+        while (m_buckets[bucket] != 0) {
+            const size_t index = m_buckets[bucket] - 1;
+            if (m_hashes[index] == h && equals(index, subset)) {
+                added = false;
+                return index;
+            }
+            bucket = (bucket + 1) & mask;
+        }
+        
+        const size_t index = size();
+        m_elements.insert(m_elements.end(), subset.begin(), subset.end());
+        m_offsets.push_back(m_elements.size());
+        m_hashes.push_back(h);
+        m_buckets[bucket] = index + 1;
+        
+        added = true;
+        return index;
+    }
+    
+    size_t DeterminizeAutomaton::SubsetIndex::size() const {
+        return m_offsets.size() - 1;
+    }
+    
+    DeterminizeAutomaton::IndexList::const_iterator DeterminizeAutomaton::SubsetIndex::begin(const size_t index) const {
+        assert(index < size());
+        return m_elements.begin() + static_cast<long>(m_offsets[index]);
+    }
+    
+    DeterminizeAutomaton::IndexList::const_iterator DeterminizeAutomaton::SubsetIndex::end(const size_t index) const {
+        assert(index < size());
+        return m_elements.begin() + static_cast<long>(m_offsets[index + 1]);
+    }
+    
+    size_t DeterminizeAutomaton::SubsetIndex::hash(const IndexList& subset) {
+        size_t result = 2166136261u;
+        IndexList::const_iterator it, end;
+        for (it = subset.begin(), end = subset.end(); it != end; ++it)
+            result = (result ^ *it) * 16777619u;
+        return result;
+    }
+    
+    bool DeterminizeAutomaton::SubsetIndex::equals(const size_t index, const IndexList& subset) const {
+        const size_t size = m_offsets[index + 1] - m_offsets[index];
+        return size == subset.size() && std::equal(subset.begin(), subset.end(), begin(index));
+    }
+    
+    void DeterminizeAutomaton::SubsetIndex::insert(const size_t index) {
+        const size_t mask = m_buckets.size() - 1;
+        size_t bucket = m_hashes[index] & mask;
+        while (m_buckets[bucket] != 0)
+            bucket = (bucket + 1) & mask;
+        m_buckets[bucket] = index + 1;
+    }
+    
+    void DeterminizeAutomaton::SubsetIndex::grow() {
+        const size_t bucketCount = m_buckets.empty() ? 16 : 2 * m_buckets.size();
+        m_buckets.assign(bucketCount, 0);
+        for (size_t index = 0; index < size(); ++index)
+            insert(index);
+    }
+    
+    DeterminizeAutomaton::DeterminizeAutomaton(const bool minimize) :
+    m_minimize(minimize) {}
+    
+    void DeterminizeAutomaton::determinize(const LabeledGraph& graph, const LabelIndex& labels, const size_t tau, const BitSet& finalStates, const size_t initialState, SimpleAutomaton& result) const {
+        const TauClosure closure(graph, tau);
+        
+        BitSet finalComponents(closure.getComponentCount());
+        for (size_t state = 0; state < graph.getStateCount(); ++state) {
+            if (finalStates.test(state))
+                finalComponents.set(closure.getComponent(state));
+        }
+        
+        SubsetIndex subsets;
+        IndexList subset;
+        bool added;
+        addClosure(closure, closure.getComponent(initialState), subset);
+        std::sort(subset.begin(), subset.end());
+        subsets.getIndex(subset, added);
+        
+        // the edges of the deterministic automaton as (source, label, target) triples
+        IndexList edges;
+        LabeledGraph::TransitionList moves;
+        for (size_t current = 0; current < subsets.size(); ++current) {
+            moves.clear();
+            
+            IndexList::const_iterator cIt, cEnd;
+            for (cIt = subsets.begin(current), cEnd = subsets.end(current); cIt != cEnd; ++cIt) {
+                const TauClosure::IndexRange members = closure.getMembers(*cIt);
+                TauClosure::IndexIterator mIt;
+                for (mIt = members.first; mIt != members.second; ++mIt) {
+                    const LabeledGraph::TransitionRange successors = graph.getSuccessors(*mIt);
+                    LabeledGraph::TransitionIterator tIt;
+                    for (tIt = successors.first; tIt != successors.second; ++tIt) {
+                        if (tIt->label != tau)
+                            moves.push_back(LabeledGraph::Transition(tIt->label, closure.getComponent(tIt->state)));
+                    }
+                }
+            }
+            
+            std::sort(moves.begin(), moves.end());
+            moves.erase(std::unique(moves.begin(), moves.end()), moves.end());
+            
+            size_t i = 0;
+            while (i < moves.size()) {
+                const size_t label = moves[i].label;
+                subset.clear();
+                while (i < moves.size() && moves[i].label == label)
+                    addClosure(closure, moves[i++].state, subset);
+                
+                std::sort(subset.begin(), subset.end());
+                subset.erase(std::unique(subset.begin(), subset.end()), subset.end());
+                
+                edges.push_back(current);
+                edges.push_back(label);
+                edges.push_back(subsets.getIndex(subset, added));
+            }
+        }
+        
+        const size_t subsetCount = subsets.size();
+        IndexList classes(subsetCount, 0);
+        for (size_t index = 0; index < subsetCount; ++index) {
+            IndexList::const_iterator cIt, cEnd;
+            for (cIt = subsets.begin(index), cEnd = subsets.end(index); cIt != cEnd && classes[index] == 0; ++cIt) {
+                if (finalComponents.test(*cIt))
+                    classes[index] = 1;
+            }
+        }
+        
+        IndexList blocks(subsetCount);
+        if (m_minimize) {
+            LabeledGraph dfa(subsetCount);
+            for (size_t i = 0; i < edges.size(); i += 3)
+                dfa.addEdge(edges[i], edges[i + 1], edges[i + 2]);
+            dfa.freeze();
+            
+            const Bisimulation bisimulation(dfa, classes);
+            for (size_t index = 0; index < subsetCount; ++index)
+                blocks[index] = bisimulation.getBlock(index);
+        } else {
+            for (size_t index = 0; index < subsetCount; ++index)
+                blocks[index] = index;
+        }
+        
+        // all subsets of a block have the same successor blocks, so only the edges of the first
+        // subset of each block are created
+        std::vector<SimpleAutomatonState*> states(subsetCount, NULL);
+        IndexList representatives(subsetCount, subsetCount);
+        for (size_t index = 0; index < subsetCount; ++index) {
+            const size_t block = blocks[index];
+            if (states[block] == NULL) {
+                StringStream name;
+                name << result.getStates().size() + 1;
+                
+                SimpleAutomatonState* state = result.createState(name.str());
+                if (classes[index] == 1) {
+                    state->setFinal(true);
+                    result.addFinalState(state);
+                }
+                
+                states[block] = state;
+                representatives[block] = index;
+            }
+        }
+        
+        result.setInitialState(states[blocks[0]]);
+        for (size_t i = 0; i < edges.size(); i += 3) {
+            const size_t source = blocks[edges[i]];
+            if (representatives[source] == edges[i])
+                result.connectWithObservableEdge(states[source], states[blocks[edges[i + 2]]], labels.getLabel(edges[i + 1]));
+        }
+    }
+    
+    void DeterminizeAutomaton::addClosure(const TauClosure& closure, const size_t component, IndexList& subset) {
+        const TauClosure::IndexRange reachable = closure.getClosure(component);
+        subset.insert(subset.end(), reachable.first, reachable.second);
+    }
+}
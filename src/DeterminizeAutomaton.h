@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__DeterminizeAutomaton__
+#define __Tippi__DeterminizeAutomaton__
+
+#include "BitSet.h"
+#include "SimpleAutomaton.h"
+#include "Simulation.h"
+
+#include <vector>
+
+namespace Tippi {
+    /**
+     Constructs a deterministic automaton without unobservable edges from a given automaton by
+     subset construction. Each state of the result represents the set of states of the given
+     automaton that can be reached by some observable trace, including all states reachable by
+     unobservable edges. A state of the result is final if it contains a final state.
+     
+     Since all states of a strongly connected component of unobservable edges have the same
+     closure, the subsets are represented by the sorted lists of the components they contain. The
+     subsets are interned in a hash table, so that each subset is stored only once.
+     
+     Optionally, the result can be minimized by merging bisimilar states, which for a
+     deterministic automaton amounts to Hopcroft's algorithm. States from which no final state is
+     reachable are kept, so the result has the same observable traces as the given automaton.
+     */
+    class DeterminizeAutomaton {
+    private:
+        typedef std::vector<size_t> IndexList;
+        
+        class SubsetIndex {
+        private:
+            IndexList m_offsets;
+            IndexList m_elements;
+            IndexList m_hashes;
+            IndexList m_buckets;
+        public:
+            SubsetIndex();
+            
+            /**
+             Returns the index of the given sorted subset, adding it if it is new.
+             
+             @param subset the subset
+             @param added is set to true if the subset was added
+             */
+            size_t getIndex(const IndexList& subset, bool& added);
+            size_t size() const;
+            
+            IndexList::const_iterator begin(size_t index) const;
+            IndexList::const_iterator end(size_t index) const;
+        private:
+            static size_t hash(const IndexList& subset);
+            bool equals(size_t index, const IndexList& subset) const;
+            void insert(size_t index);
+            void grow();
+        };
+        
+        bool m_minimize;
+    public:
+        DeterminizeAutomaton(bool minimize = false);
+        
+        template <class A>
+        SimpleAutomaton::Ptr operator()(const A& automaton) const {
+            SimpleAutomaton::Ptr result(new SimpleAutomaton());
+            const typename A::State* initialState = automaton.getInitialState();
+            if (initialState == NULL)
+                return result;
+            
+            LabelIndex labels;
+            const size_t tau = labels.getIndex(Label());
+            const LabeledGraph graph = LabeledGraph::build(automaton, labels);
+            
+            BitSet finalStates(graph.getStateCount());
+            const typename A::StateSet& states = automaton.getFinalStates();
+            typename A::StateSet::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it) {
+                const typename A::State* state = *it;
+                finalStates.set(state->getId());
+            }
+            
+            determinize(graph, labels, tau, finalStates, initialState->getId(), *result);
+            return result;
+        }
+    private:
+        void determinize(const LabeledGraph& graph, const LabelIndex& labels, size_t tau, const BitSet& finalStates, size_t initialState, SimpleAutomaton& result) const;
+        static void addClosure(const TauClosure& closure, size_t component, IndexList& subset);
+    };
+}
+
+#endif /* defined(__Tippi__DeterminizeAutomaton__) */
@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ForwardBackwardComponents.h"
+
+#include <cassert>
+
+namespace Tippi {
+    const size_t ForwardBackwardComponents::None = static_cast<size_t>(-1);
+    
+    ForwardBackwardComponents::ForwardBackwardComponents(const LabeledGraph& graph, const size_t root) {
+        assert(root < graph.getStateCount());
+        m_memberOffsets.push_back(0);
+        
+        // the index of the open part of each state, or None if the state is not in an open part
+        IndexList partOf(graph.getStateCount(), None);
+        std::vector<char> marks(graph.getStateCount(), 0);
+        
+        // the states reachable from the root form the first part
+        IndexList reachable;
+        reachable.push_back(root);
+        marks[root] = 1;
+        for (size_t i = 0; i < reachable.size(); ++i) {
+            const LabeledGraph::TransitionRange successors = graph.getSuccessors(reachable[i]);
+            LabeledGraph::TransitionIterator tIt;
+            for (tIt = successors.first; tIt != successors.second; ++tIt) {
+                if (marks[tIt->state] == 0) {
+                    marks[tIt->state] = 1;
+                    reachable.push_back(tIt->state);
+                }
+            }
+        }
+        
+        IndexList::const_iterator it, end;
+        for (it = reachable.begin(), end = reachable.end(); it != end; ++it)
+            marks[*it] = 0;
+        
+        IndexListList parts;
+        IndexListList nextParts;
+        addPart(reachable, parts, partOf);
+        
+        std::vector<Parts> results;
+        while (!parts.empty()) {
+            results.clear();
+            results.resize(parts.size());
+            
+            // the parts are disjoint, and every call only writes the marks of the states of its part
+            const long partCount = static_cast<long>(parts.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (long i = 0; i < partCount; ++i)
+                decompose(graph, parts[static_cast<size_t>(i)], partOf, marks, results[static_cast<size_t>(i)]);
+            
+            nextParts.clear();
+            std::vector<Parts>::const_iterator rIt, rEnd;
+            for (rIt = results.begin(), rEnd = results.end(); rIt != rEnd; ++rIt) {
+                const Parts& result = *rIt;
+                for (it = result.component.begin(), end = result.component.end(); it != end; ++it)
+                    partOf[*it] = None;
+                m_members.insert(m_members.end(), result.component.begin(), result.component.end());
+                m_memberOffsets.push_back(m_members.size());
+                
+                addPart(result.forward, nextParts, partOf);
+                addPart(result.backward, nextParts, partOf);
+                addPart(result.remainder, nextParts, partOf);
+            }
+            
+            parts.swap(nextParts);
+        }
+    }
+    
+    size_t ForwardBackwardComponents::getComponentCount() const {
+        return m_memberOffsets.size() - 1;
+    }
+    
+    ForwardBackwardComponents::IndexRange ForwardBackwardComponents::getMembers(const size_t component) const {
+        assert(component < getComponentCount());
+        return IndexRange(m_members.begin() + static_cast<long>(m_memberOffsets[component]),
+                          m_members.begin() + static_cast<long>(m_memberOffsets[component + 1]));
+    }
+    
+    void ForwardBackwardComponents::decompose(const LabeledGraph& graph, const IndexList& part, const IndexList& partOf, std::vector<char>& marks, Parts& result) {
+        assert(!part.empty());
+        const size_t pivot = part.front();
+        mark(graph, pivot, true, 1, partOf, marks);
+        mark(graph, pivot, false, 2, partOf, marks);
+        
+        IndexList::const_iterator it, end;
+        for (it = part.begin(), end = part.end(); it != end; ++it) {
+            const size_t state = *it;
+            switch (marks[state]) {
+                case 3:
+                    result.component.push_back(state);
+                    break;
+                case 1:
+                    result.forward.push_back(state);
+                    break;
+                case 2:
+                    result.backward.push_back(state);
+                    break;
+                default:
+                    result.remainder.push_back(state);
+                    break;
+            }
+            marks[state] = 0;
+        }
+    }
+    
+    void ForwardBackwardComponents::mark(const LabeledGraph& graph, const size_t pivot, const bool forward, const char flag, const IndexList& partOf, std::vector<char>& marks) {
+        const size_t part = partOf[pivot];
+        
+        IndexList queue;
+        queue.push_back(pivot);
+        marks[pivot] = static_cast<char>(marks[pivot] | flag);
+        
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const LabeledGraph::TransitionRange transitions = forward ? graph.getSuccessors(queue[i]) : graph.getPredecessors(queue[i]);
+            LabeledGraph::TransitionIterator tIt;
+            for (tIt = transitions.first; tIt != transitions.second; ++tIt) {
+                const size_t state = tIt->state;
+                if (partOf[state] == part && (marks[state] & flag) == 0) {
+                    marks[state] = static_cast<char>(marks[state] | flag);
+                    queue.push_back(state);
+                }
+            }
+        }
+    }
+    
+    void ForwardBackwardComponents::addPart(const IndexList& states, IndexListList& parts, IndexList& partOf) {
+        if (states.empty())
+            return;
+        
+        const size_t part = parts.size();
+        IndexList::const_iterator it, end;
+        for (it = states.begin(), end = states.end(); it != end; ++it)
+            partOf[*it] = part;
+        parts.push_back(states);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__ForwardBackwardComponents__
+#define __Tippi__ForwardBackwardComponents__
+
+#include "Simulation.h"
+
+#include <utility>
+#include <vector>
+
+namespace Tippi {
+    /**
+     Computes the strongly connected components of the states of a labeled graph that are reachable
+     from a given state using the forward-backward algorithm. For a set of states and a pivot state
+     in it, the component of the pivot is the intersection of the states that are reachable from
+     the pivot and the states from which the pivot is reachable. Every other component is contained
+     in one of the three remaining parts of the set, which are decomposed independently.
+     
+     All parts of a round are decomposed in parallel if OpenMP is available. Unlike Tarjan's
+     algorithm, the components are not found in any particular order.
+     */
+    class ForwardBackwardComponents {
+    public:
+        typedef std::vector<size_t> IndexList;
+        typedef IndexList::const_iterator IndexIterator;
+        typedef std::pair<IndexIterator, IndexIterator> IndexRange;
+    private:
+        struct Parts {
+            IndexList component;
+            IndexList forward;
+            IndexList backward;
+            IndexList remainder;
+        };
+        
+        typedef std::vector<IndexList> IndexListList;
+        
+        static const size_t None;
+        
+        IndexList m_memberOffsets;
+        IndexList m_members;
+    public:
+        ForwardBackwardComponents(const LabeledGraph& graph, size_t root);
+        
+        size_t getComponentCount() const;
+        IndexRange getMembers(size_t component) const;
+    private:
+        static void decompose(const LabeledGraph& graph, const IndexList& part, const IndexList& partOf, std::vector<char>& marks, Parts& result);
+        static void mark(const LabeledGraph& graph, size_t pivot, bool forward, char flag, const IndexList& partOf, std::vector<char>& marks);
+        static void addPart(const IndexList& states, IndexListList& parts, IndexList& partOf);
+    };
+}
+
+#endif /* defined(__Tippi__ForwardBackwardComponents__) */
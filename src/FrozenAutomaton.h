@@ -0,0 +1,282 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__FrozenAutomaton__
+#define __Tippi__FrozenAutomaton__
+
+#include "BitSet.h"
+#include "Label.h"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace Tippi {
+    /**
+     Determines the value of the edge type column of a frozen automaton. By default, the type of an
+     edge is 1 if the edge is observable and 0 otherwise. Automata with other edge types can
+     specialize this template.
+     */
+    template <class EdgeT>
+    struct FrozenEdgeType {
+        static unsigned char get(const EdgeT* edge) {
+            return edge->isObservable() ? 1 : 0;
+        }
+    };
+    
+    /**
+     Determines the state flags of a frozen automaton. Every flag is stored in a bit set that is
+     indexed by the dense state indices. By default, no flags other than the final flag, which every
+     frozen automaton stores, are recorded. Automata whose passes need other flags can specialize
+     this template, which must provide the number of flags as FlagCount and a function that
+     computes the value of a flag for a given state.
+     */
+    template <class StateT>
+    struct FrozenStateFlags {
+        static const size_t FlagCount = 0;
+        
+        static bool get(const StateT*, size_t) {
+            assert(false);
+            return false;
+        }
+    };
+    
+    /**
+     An immutable snapshot of the structure of an automaton, stored as a structure of arrays.
+     
+     The states are renumbered with dense indices in breadth first order from the initial state, so
+     the states reachable from the initial state occupy the indices below getReachableCount(), and
+     the remaining states follow in the order of the automaton's state set. The outgoing and
+     incoming edges of every state are stored in compressed sparse row form, that is, in contiguous
+     ranges of parallel arrays which hold the adjacent states, the labels, the edge types and the
+     original edges. The edges of every range have the same order as in the automaton.
+     
+     Since a frozen automaton is never modified, any number of read only passes can run over it at
+     the same time. The snapshot becomes invalid when the structure of the automaton changes.
+     */
+    template <class StateT, class EdgeT>
+    class FrozenAutomaton {
+    public:
+        typedef std::vector<size_t> IndexList;
+        typedef std::pair<size_t, size_t> EdgeRange;
+        
+        static const size_t None = static_cast<size_t>(-1);
+    private:
+        typedef FrozenStateFlags<StateT> Flags;
+        
+        struct Adjacency {
+            IndexList offsets;
+            IndexList states;
+            std::vector<Label> labels;
+            std::vector<unsigned char> types;
+            std::vector<EdgeT*> edges;
+        };
+        
+        std::vector<StateT*> m_states;
+        IndexList m_indexOfId;
+        size_t m_reachableCount;
+        
+        Adjacency m_successors;
+        Adjacency m_predecessors;
+        
+        BitSet m_final;
+        std::vector<BitSet> m_flags;
+    public:
+        /**
+         Creates a snapshot of the automaton with the given initial state and states.
+         
+         @param initialState the initial state, which may be NULL
+         @param states the states of the automaton
+         @param maxId the maximal id of the given states
+         */
+        template <class S>
+        FrozenAutomaton(StateT* initialState, const S& states, const size_t maxId) :
+        m_indexOfId(maxId + 1, None),
+        m_reachableCount(0),
+        m_final(states.size()),
+        m_flags(Flags::FlagCount, BitSet(states.size())) {
+            m_states.reserve(states.size());
+            if (initialState != NULL)
+                numberReachableStates(initialState);
+            m_reachableCount = m_states.size();
+            
+            typename S::const_iterator it, end;
+            for (it = states.begin(), end = states.end(); it != end; ++it) {
+                StateT* state = *it;
+                if (m_indexOfId[state->getId()] == None)
+                    addState(state);
+            }
+            
+            for (size_t i = 0; i < m_states.size(); ++i) {
+                const StateT* state = m_states[i];
+                if (state->isFinal())
+                    m_final.set(i);
+                for (size_t flag = 0; flag < Flags::FlagCount; ++flag) {
+                    if (Flags::get(state, flag))
+                        m_flags[flag].set(i);
+                }
+            }
+            
+            buildAdjacency(true, m_successors);
+            buildAdjacency(false, m_predecessors);
+        }
+        
+        size_t getStateCount() const {
+            return m_states.size();
+        }
+        
+        /**
+         Returns the number of states that are reachable from the initial state. These states have
+         the indices 0 to getReachableCount() - 1, and the initial state has index 0.
+         */
+        size_t getReachableCount() const {
+            return m_reachableCount;
+        }
+        
+        size_t getEdgeCount() const {
+            return m_successors.states.size();
+        }
+        
+        StateT* getState(const size_t index) const {
+            assert(index < m_states.size());
+            return m_states[index];
+        }
+        
+        /**
+         Returns the dense index of the given state or None if the state is not part of this
+         snapshot.
+         */
+        size_t getIndex(const StateT* state) const {
+            assert(state != NULL);
+            const size_t id = state->getId();
+            return id < m_indexOfId.size() ? m_indexOfId[id] : None;
+        }
+        
+        bool isReachable(const size_t index) const {
+            assert(index < m_states.size());
+            return index < m_reachableCount;
+        }
+        
+        bool isFinal(const size_t index) const {
+            return m_final.test(index);
+        }
+        
+        bool hasFlag(const size_t index, const size_t flag) const {
+            assert(flag < m_flags.size());
+            return m_flags[flag].test(index);
+        }
+        
+        /**
+         Returns the range of the outgoing edges of the given state. The edges in this range can be
+         inspected with getSuccessor, getSuccessorLabel, getSuccessorType and getSuccessorEdge.
+         */
+        EdgeRange getSuccessors(const size_t index) const {
+            return getRange(m_successors, index);
+        }
+        
+        size_t getSuccessor(const size_t edge) const {
+            return m_successors.states[edge];
+        }
+        
+        const Label& getSuccessorLabel(const size_t edge) const {
+            return m_successors.labels[edge];
+        }
+        
+        unsigned char getSuccessorType(const size_t edge) const {
+            return m_successors.types[edge];
+        }
+        
+        EdgeT* getSuccessorEdge(const size_t edge) const {
+            return m_successors.edges[edge];
+        }
+        
+        /**
+         Returns the range of the incoming edges of the given state. The edges in this range can be
+         inspected with getPredecessor, getPredecessorLabel, getPredecessorType and
+         getPredecessorEdge.
+         */
+        EdgeRange getPredecessors(const size_t index) const {
+            return getRange(m_predecessors, index);
+        }
+        
+        size_t getPredecessor(const size_t edge) const {
+            return m_predecessors.states[edge];
+        }
+        
+        const Label& getPredecessorLabel(const size_t edge) const {
+            return m_predecessors.labels[edge];
+        }
+        
+        unsigned char getPredecessorType(const size_t edge) const {
+            return m_predecessors.types[edge];
+        }
+        
+        EdgeT* getPredecessorEdge(const size_t edge) const {
+            return m_predecessors.edges[edge];
+        }
+    private:
+        void addState(StateT* state) {
+            m_indexOfId[state->getId()] = m_states.size();
+            m_states.push_back(state);
+        }
+        
+        void numberReachableStates(StateT* initialState) {
+            addState(initialState);
+            for (size_t i = 0; i < m_states.size(); ++i) {
+                const typename StateT::OutgoingList& outgoing = m_states[i]->getOutgoing();
+                typename StateT::OutgoingList::const_iterator it, end;
+                for (it = outgoing.begin(), end = outgoing.end(); it != end; ++it) {
+                    StateT* target = (*it)->getTarget();
+                    if (m_indexOfId[target->getId()] == None)
+                        addState(target);
+                }
+            }
+        }
+        
+        void buildAdjacency(const bool forward, Adjacency& adjacency) const {
+            adjacency.offsets.reserve(m_states.size() + 1);
+            adjacency.offsets.push_back(0);
+            
+            for (size_t i = 0; i < m_states.size(); ++i) {
+                const StateT* state = m_states[i];
+                const std::vector<EdgeT*>& edges = forward ? state->getOutgoing() : state->getIncoming();
+                typename std::vector<EdgeT*>::const_iterator it, end;
+                for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+                    EdgeT* edge = *it;
+                    const StateT* neighbour = forward ? edge->getTarget() : edge->getSource();
+                    adjacency.states.push_back(getIndex(neighbour));
+                    adjacency.labels.push_back(edge->getLabel());
+                    adjacency.types.push_back(FrozenEdgeType<EdgeT>::get(edge));
+                    adjacency.edges.push_back(edge);
+                }
+                adjacency.offsets.push_back(adjacency.states.size());
+            }
+        }
+        
+        static EdgeRange getRange(const Adjacency& adjacency, const size_t index) {
+            assert(index + 1 < adjacency.offsets.size());
+            return EdgeRange(adjacency.offsets[index], adjacency.offsets[index + 1]);
+        }
+    };
+    
+    template <class StateT, class EdgeT>
+    const size_t FrozenAutomaton<StateT, EdgeT>::None;
+}
+
+#endif /* defined(__Tippi__FrozenAutomaton__) */
@@ -20,94 +20,315 @@
 #ifndef Tippi_GraphAlgorithms_h
 #define Tippi_GraphAlgorithms_h
 
+#include "BitSet.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace Tippi {
-    template <class NodeVisitor, class EdgeVisitor>
+    /**
+     Maps an automaton state to its id.
+     */
+    struct StateId {
+        template <typename State>
+        size_t operator()(const State* state) const {
+            return state->getId();
+        }
+    };
+    
+    /**
+     Records which nodes of a graph a traversal has visited. The nodes are mapped to indices by the
+     given key function, and the visited nodes are marked in a bit set which grows as needed. Since
+     the nodes themselves are not modified, any number of traversals can run over the same graph at
+     the same time as long as each of them uses its own visited set.
+     */
+    template <typename Key = StateId>
+    class VisitedSet {
+    private:
+        BitSet m_visited;
+        Key m_key;
+    public:
+        VisitedSet(const size_t size = 0, const Key& key = Key()) :
+        m_visited(size),
+        m_key(key) {}
+        
+        template <typename Node>
+        bool isVisited(const Node* node) const {
+            const size_t index = m_key(node);
+            return index < m_visited.size() && m_visited.test(index);
+        }
+        
+        /**
+         Marks the given node as visited.
+         
+         @param node the node to mark
+         @return true if the node had not been visited before and false otherwise
+         */
+        template <typename Node>
+        bool visit(const Node* node) {
+            const size_t index = m_key(node);
+            if (index >= m_visited.size())
+                m_visited.resize(std::max(index + 1, 2 * m_visited.size()));
+            return m_visited.testAndSet(index);
+        }
+    };
+    
+    /**
+     Calls the functions of traversal visitors. A visitor function may return either void or bool.
+     If it returns false, the traversal stops immediately, otherwise it continues.
+     */
+    namespace Visit {
+        template <typename Visitor, typename Node>
+        typename std::enable_if<std::is_void<decltype(std::declval<Visitor&>().visitNode(std::declval<Node*>()))>::value, bool>::type
+        node(Visitor& visitor, Node* node) {
+            visitor.visitNode(node);
+            return true;
+        }
+        
+        template <typename Visitor, typename Node>
+        typename std::enable_if<!std::is_void<decltype(std::declval<Visitor&>().visitNode(std::declval<Node*>()))>::value, bool>::type
+        node(Visitor& visitor, Node* node) {
+            return visitor.visitNode(node);
+        }
+        
+        template <typename Visitor, typename Node>
+        typename std::enable_if<std::is_void<decltype(std::declval<Visitor&>().initNode(std::declval<Node*>()))>::value, bool>::type
+        initNode(Visitor& visitor, Node* node) {
+            visitor.initNode(node);
+            return true;
+        }
+        
+        template <typename Visitor, typename Node>
+        typename std::enable_if<!std::is_void<decltype(std::declval<Visitor&>().initNode(std::declval<Node*>()))>::value, bool>::type
+        initNode(Visitor& visitor, Node* node) {
+            return visitor.initNode(node);
+        }
+        
+        template <typename Visitor, typename Edge>
+        typename std::enable_if<std::is_void<decltype(std::declval<Visitor&>().visitEdge(std::declval<Edge*>()))>::value, bool>::type
+        edge(Visitor& visitor, Edge* edge) {
+            visitor.visitEdge(edge);
+            return true;
+        }
+        
+        template <typename Visitor, typename Edge>
+        typename std::enable_if<!std::is_void<decltype(std::declval<Visitor&>().visitEdge(std::declval<Edge*>()))>::value, bool>::type
+        edge(Visitor& visitor, Edge* edge) {
+            return visitor.visitEdge(edge);
+        }
+    }
+    
+    /**
+     Visits the nodes that are reachable from a given node in breadth first order. A node is passed
+     to visitNode when it is discovered, and every outgoing edge of a discovered node is passed to
+     visitEdge before its target is discovered.
+     
+     The traversal keeps the nodes of the current and the next level in two lists instead of
+     recursing, so it works on graphs of any depth. Since the lists may have different types, the
+     traversal also works on bipartite graphs such as interval nets, where the outgoing edges of
+     places lead to transitions and vice versa.
+     */
+    template <class NodeVisitor, class EdgeVisitor, class Visited = VisitedSet<> >
     class BreadthFirst {
     private:
         NodeVisitor& m_nodeVisitor;
         EdgeVisitor& m_edgeVisitor;
+        Visited& m_visited;
     public:
-        BreadthFirst(NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor) :
+        BreadthFirst(NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor, Visited& visited) :
         m_nodeVisitor(nodeVisitor),
-        m_edgeVisitor(edgeVisitor) {}
+        m_edgeVisitor(edgeVisitor),
+        m_visited(visited) {}
         
+        /**
+         Visits the given node and all nodes reachable from it which have not been visited yet.
+         
+         @param root the node to start at
+         @return false if a visitor stopped the traversal and true otherwise
+         */
         template <typename Node>
-        void operator()(Node* node) {
-            visit(node);
+        bool operator()(Node* root) {
+            typedef typename Node::Outgoing::Target Next;
+            
+            if (!m_visited.visit(root))
+                return true;
+            if (!Visit::node(m_nodeVisitor, root))
+                return false;
+            
+            std::vector<Node*> current(1, root);
+            std::vector<Next*> next;
+            while (!current.empty()) {
+                if (!expand(current, next))
+                    return false;
+                current.clear();
+                if (!expand(next, current))
+                    return false;
+                next.clear();
+            }
+            return true;
         }
     private:
-        template <typename Node>
-        void visit(Node* node) {
-            if (node->isVisited())
-                return;
+        template <typename Node, typename Next>
+        bool expand(const std::vector<Node*>& level, std::vector<Next*>& nextLevel) {
+            typedef typename Node::OutgoingList OutList;
             
-            node->setVisited(true);
-            m_nodeVisitor.visitNode(node);
-
-            typedef typename Node::Outgoing::List OutList;
-            const OutList& edges = node->getOutgoing();
-            typename OutList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
-                typename Node::Outgoing* edge = *it;
-                
-                edge->setVisited(true);
-                m_edgeVisitor.visitEdge(edge);
-                
-                visit(edge->getTarget());
+            typename std::vector<Node*>::const_iterator nIt, nEnd;
+            for (nIt = level.begin(), nEnd = level.end(); nIt != nEnd; ++nIt) {
+                Node* node = *nIt;
+                const OutList& edges = node->getOutgoing();
+                typename OutList::const_iterator eIt, eEnd;
+                for (eIt = edges.begin(), eEnd = edges.end(); eIt != eEnd; ++eIt) {
+                    typename Node::Outgoing* edge = *eIt;
+                    if (!Visit::edge(m_edgeVisitor, edge))
+                        return false;
+                    
+                    Next* target = edge->getTarget();
+                    if (m_visited.visit(target)) {
+                        if (!Visit::node(m_nodeVisitor, target))
+                            return false;
+                        nextLevel.push_back(target);
+                    }
+                }
             }
+            return true;
         }
     };
     
-    template <class Node, class NodeVisitor, class EdgeVisitor>
-    void breadthFirst(Node* root, NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor) {
-        BreadthFirst<NodeVisitor, EdgeVisitor> visitNode(nodeVisitor, edgeVisitor);
-        visitNode(root);
+    template <class Node, class NodeVisitor, class EdgeVisitor, class Visited>
+    bool breadthFirst(Node* root, NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor, Visited& visited) {
+        BreadthFirst<NodeVisitor, EdgeVisitor, Visited> visitNode(nodeVisitor, edgeVisitor, visited);
+        return visitNode(root);
     }
     
-    template <class NodeVisitor, class EdgeVisitor>
-    class DepthFirst {
+    /**
+     Visits the nodes that are reachable from a given node in depth first order using an explicit
+     stack, so it works on graphs of any depth.
+     
+     In post order (DepthFirst), a node is passed to initNode when it is discovered and to visitNode
+     once all of its successors are finished, and an edge is passed to visitEdge after its target is
+     finished. In pre order (PreOrder), a node is passed to visitNode when it is discovered, and an
+     edge is passed to visitEdge before its target is explored.
+     
+     The stack is split into two stacks which hold the frames at odd and even depths, so that the
+     traversal also works on bipartite graphs such as interval nets.
+     */
+    template <bool PostOrder, class NodeVisitor, class EdgeVisitor, class Visited>
+    class DepthFirstSearch {
     private:
+        template <typename Node>
+        struct Frame {
+            Node* node;
+            size_t edge;
+            
+            Frame(Node* i_node) :
+            node(i_node),
+            edge(0) {}
+        };
+        
         NodeVisitor& m_nodeVisitor;
         EdgeVisitor& m_edgeVisitor;
+        Visited& m_visited;
     public:
-        DepthFirst(NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor) :
+        DepthFirstSearch(NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor, Visited& visited) :
         m_nodeVisitor(nodeVisitor),
-        m_edgeVisitor(edgeVisitor) {}
+        m_edgeVisitor(edgeVisitor),
+        m_visited(visited) {}
         
+        /**
+         Visits the given node and all nodes reachable from it which have not been visited yet.
+         
+         @param root the node to start at
+         @return false if a visitor stopped the traversal and true otherwise
+         */
         template <typename Node>
-        void operator()(Node* node) {
-            visit(node);
+        bool operator()(Node* root) {
+            typedef typename Node::Outgoing::Target Next;
+            
+            if (!m_visited.visit(root))
+                return true;
+            if (!discover(root))
+                return false;
+            
+            std::vector<Frame<Node> > even(1, Frame<Node>(root));
+            std::vector<Frame<Next> > odd;
+            while (!even.empty()) {
+                // the root is at depth zero, so the top frame is on the even stack iff it is higher
+                const bool proceed = even.size() > odd.size() ? step(even, odd) : step(odd, even);
+                if (!proceed)
+                    return false;
+            }
+            return true;
         }
     private:
         template <typename Node>
-        void visit(Node* node) {
-            if (node->isVisited())
-                return;
+        bool discover(Node* node) {
+            return discover(node, std::integral_constant<bool, PostOrder>());
+        }
+        
+        template <typename Node>
+        bool discover(Node* node, std::true_type) {
+            return Visit::initNode(m_nodeVisitor, node);
+        }
+        
+        template <typename Node>
+        bool discover(Node* node, std::false_type) {
+            return Visit::node(m_nodeVisitor, node);
+        }
+        
+        template <typename Node, typename Next>
+        bool step(std::vector<Frame<Node> >& top, std::vector<Frame<Next> >& parents) {
+            Frame<Node>& frame = top.back();
+            Node* node = frame.node;
+            const typename Node::OutgoingList& edges = node->getOutgoing();
+            
+            if (frame.edge == edges.size()) {
+                top.pop_back();
+                if (PostOrder) {
+                    if (!Visit::node(m_nodeVisitor, node))
+                        return false;
+                    if (!parents.empty()) {
+                        const Frame<Next>& parent = parents.back();
+                        if (!Visit::edge(m_edgeVisitor, parent.node->getOutgoing()[parent.edge - 1]))
+                            return false;
+                    }
+                }
+                return true;
+            }
             
-            node->setVisited(true);
-            m_nodeVisitor.initNode(node);
+            typename Node::Outgoing* edge = edges[frame.edge++];
+            if (!PostOrder && !Visit::edge(m_edgeVisitor, edge))
+                return false;
             
-            typedef typename Node::Outgoing::List OutList;
-            const OutList& edges = node->getOutgoing();
-            typename OutList::const_iterator it, end;
-            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
-                typename Node::Outgoing* edge = *it;
-                
-                edge->setVisited(true);
-                visit(edge->getTarget());
-                
-                m_edgeVisitor.visitEdge(edge);
+            Next* target = edge->getTarget();
+            if (m_visited.visit(target)) {
+                if (!discover(target))
+                    return false;
+                parents.push_back(Frame<Next>(target));
+            } else if (PostOrder && !Visit::edge(m_edgeVisitor, edge)) {
+                return false;
             }
-
-            m_nodeVisitor.visitNode(node);
+            return true;
         }
     };
-
     
-    template <class Node, class NodeVisitor, class EdgeVisitor>
-    void depthFirst(Node* root, NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor) {
-        DepthFirst<NodeVisitor, EdgeVisitor> visitNode(nodeVisitor, edgeVisitor);
-        visitNode(root);
+    template <class NodeVisitor, class EdgeVisitor, class Visited = VisitedSet<> >
+    using DepthFirst = DepthFirstSearch<true, NodeVisitor, EdgeVisitor, Visited>;
+    
+    template <class NodeVisitor, class EdgeVisitor, class Visited = VisitedSet<> >
+    using PreOrder = DepthFirstSearch<false, NodeVisitor, EdgeVisitor, Visited>;
+    
+    template <class Node, class NodeVisitor, class EdgeVisitor, class Visited>
+    bool depthFirst(Node* root, NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor, Visited& visited) {
+        DepthFirst<NodeVisitor, EdgeVisitor, Visited> visitNode(nodeVisitor, edgeVisitor, visited);
+        return visitNode(root);
+    }
+    
+    template <class Node, class NodeVisitor, class EdgeVisitor, class Visited>
+    bool preOrder(Node* root, NodeVisitor& nodeVisitor, EdgeVisitor& edgeVisitor, Visited& visited) {
+        PreOrder<NodeVisitor, EdgeVisitor, Visited> visitNode(nodeVisitor, edgeVisitor, visited);
+        return visitNode(root);
     }
 }
 
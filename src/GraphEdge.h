@@ -24,6 +24,9 @@
 #include <vector>
 
 namespace Tippi {
+    template <typename IncomingT, typename OutgoingT>
+    class GraphNode;
+    
     template <typename SourceT, typename TargetT>
     class GraphEdge {
     public:
@@ -34,13 +37,21 @@ namespace Tippi {
         SourceT* m_source;
         TargetT* m_target;
         size_t m_multiplicity;
-        mutable bool m_visited;
+    private:
+        template <typename IncomingT, typename OutgoingT>
+        friend class GraphNode;
+        
+        // the positions of this edge in the outgoing edges of its source and the incoming edges
+        // of its target, maintained by GraphNode so that an edge can be unlinked in constant time
+        size_t m_sourceIndex;
+        size_t m_targetIndex;
     public:
         GraphEdge(SourceT* source, TargetT* target, const size_t multiplicity = 1) :
         m_source(source),
         m_target(target),
         m_multiplicity(multiplicity),
-        m_visited(false) {
+        m_sourceIndex(0),
+        m_targetIndex(0) {
             assert(m_source != NULL);
             assert(m_target != NULL);
             assert(m_multiplicity > 0);
@@ -102,14 +113,6 @@ namespace Tippi {
         bool isLoop() const {
             return m_target == m_source;
         }
-        
-        bool isVisited() const {
-            return m_visited;
-        }
-        
-        void setVisited(const bool visited) const {
-            m_visited = visited;
-        }
     };
 }
 
@@ -23,6 +23,7 @@
 #include "CollectionUtils.h"
 
 #include <algorithm>
+#include <cassert>
 #include <set>
 
 namespace Tippi {
@@ -33,23 +34,42 @@ namespace Tippi {
         typedef OutgoingT Outgoing;
         typedef std::vector<IncomingT*> IncomingList;
         typedef std::vector<OutgoingT*> OutgoingList;
-    private:
-        mutable bool m_visited;
     protected:
         IncomingList m_incoming;
         OutgoingList m_outgoing;
     public:
-        GraphNode() :
-        m_visited(false) {}
+        GraphNode() {}
         
         virtual ~GraphNode() {}
     
         void addIncoming(IncomingT* edge) {
+            edge->m_targetIndex = m_incoming.size();
             m_incoming.push_back(edge);
         }
 
+        /**
+         Removes the given incoming edge in constant time by moving the last incoming edge into its
+         place. The order of the remaining edges is therefore not preserved.
+         */
         void removeIncoming(IncomingT* edge) {
-            VectorUtils::remove(m_incoming, edge);
+            const size_t index = edge->m_targetIndex;
+            assert(index < m_incoming.size() && m_incoming[index] == edge);
+            
+            IncomingT* last = m_incoming.back();
+            last->m_targetIndex = index;
+            m_incoming[index] = last;
+            m_incoming.pop_back();
+        }
+        
+        /**
+         Removes all incoming edges that satisfy the given predicate in a single pass. The order of
+         the remaining edges is preserved.
+         */
+        template <typename P>
+        void removeIncomingIf(const P& predicate) {
+            m_incoming.erase(std::remove_if(m_incoming.begin(), m_incoming.end(), predicate), m_incoming.end());
+            for (size_t i = 0; i < m_incoming.size(); ++i)
+                m_incoming[i]->m_targetIndex = i;
         }
         
         template <typename NodeT>
@@ -73,11 +93,33 @@ namespace Tippi {
         }
 
         void addOutgoing(OutgoingT* edge) {
+            edge->m_sourceIndex = m_outgoing.size();
             m_outgoing.push_back(edge);
         }
 
+        /**
+         Removes the given outgoing edge in constant time by moving the last outgoing edge into its
+         place. The order of the remaining edges is therefore not preserved.
+         */
         void removeOutgoing(OutgoingT* edge) {
-            VectorUtils::remove(m_outgoing, edge);
+            const size_t index = edge->m_sourceIndex;
+            assert(index < m_outgoing.size() && m_outgoing[index] == edge);
+            
+            OutgoingT* last = m_outgoing.back();
+            last->m_sourceIndex = index;
+            m_outgoing[index] = last;
+            m_outgoing.pop_back();
+        }
+        
+        /**
+         Removes all outgoing edges that satisfy the given predicate in a single pass. The order of
+         the remaining edges is preserved.
+         */
+        template <typename P>
+        void removeOutgoingIf(const P& predicate) {
+            m_outgoing.erase(std::remove_if(m_outgoing.begin(), m_outgoing.end(), predicate), m_outgoing.end());
+            for (size_t i = 0; i < m_outgoing.size(); ++i)
+                m_outgoing[i]->m_sourceIndex = i;
         }
 
         const OutgoingList& getOutgoing() const {
@@ -128,22 +170,6 @@ namespace Tippi {
             return true;
         }
         
-        bool isVisited() const {
-            return m_visited;
-        }
-        
-        void setVisited(const bool visited) const {
-            m_visited = visited;
-        }
-        
-        template <typename I>
-        static void resetVisited(I cur, I end) {
-            while (cur != end) {
-                (*cur)->setVisited(false);
-                ++cur;
-            }
-        }
-        
         static OutgoingT* connectToTarget(typename OutgoingT::Source* source, typename OutgoingT::Target* target) {
             OutgoingT* e = new OutgoingT(source, target);
             source->addOutgoing(e);
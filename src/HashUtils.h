@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef Tippi_HashUtils_h
+#define Tippi_HashUtils_h
+
+#include <stdint.h>
+
+namespace Tippi {
+    namespace HashUtils {
+        typedef uint64_t Hash;
+        
+        /**
+         Scrambles the given value so that every bit of the result depends on every bit of the
+         argument (the SplitMix64 finalizer). The function is a bijection on 64 bit values.
+         */
+        inline Hash mix(Hash value) {
+            value += 0x9e3779b97f4a7c15ULL;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            return value ^ (value >> 31);
+        }
+        
+        /**
+         Combines the given hash with another value. In contrast to the boost style hash_combine,
+         the result is always 64 bits wide and well mixed, regardless of the width of size_t.
+         */
+        inline Hash combine(const Hash seed, const Hash value) {
+            return mix(seed ^ mix(value));
+        }
+    }
+}
+
+#endif
@@ -37,11 +37,11 @@ namespace Tippi {
             return m_interval;
         }
 
-        const String& Transition::getLabel() const {
+        const Label& Transition::getLabel() const {
             return m_label;
         }
         
-        void Transition::setLabel(const String& label) {
+        void Transition::setLabel(const Label& label) {
             m_label = label;
         }
 
@@ -23,6 +23,7 @@
 #include "StringUtils.h"
 #include "GraphEdge.h"
 #include "GraphNode.h"
+#include "Label.h"
 #include "Marking.h"
 #include "NetNode.h"
 #include "TimeInterval.h"
@@ -45,13 +46,13 @@ namespace Tippi {
             typedef std::vector<Transition*> List;
         private:
             TimeInterval m_interval;
-            String m_label;
+            Label m_label;
         public:
             Transition(const String& name, const size_t index, const TimeInterval& interval);
             
             const TimeInterval& getInterval() const;
-            const String& getLabel() const;
-            void setLabel(const String& label);
+            const Label& getLabel() const;
+            void setLabel(const Label& label);
             
             bool isInputSend() const;
             bool isInputRead() const;
@@ -62,6 +62,14 @@ namespace Tippi {
                 return -1;
             return 0;
         }
+        
+        HashUtils::Hash FiringRule::Closure::hash64(const HashUtils::Hash seed) const {
+            HashUtils::Hash result = HashUtils::combine(seed, m_states.size());
+            NetState::Set::const_iterator it, end;
+            for (it = m_states.begin(), end = m_states.end(); it != end; ++it)
+                result = it->hash64(result);
+            return result;
+        }
 
         bool FiringRule::Closure::isEmpty() const {
             return m_states.empty();
@@ -141,17 +149,28 @@ namespace Tippi {
         }
         
         NetState FiringRule::fireTransition(const Transition* transition, const NetState& state) const {
+            NetState newState(state);
+            fireTransition(transition, state, newState);
+            return newState;
+        }
+        
+        /**
+         Fires the given transition in the given state and stores the successor in the given
+         result state. The result state can be reused for many successors, in which case its
+         storage is reused as well.
+         */
+        void FiringRule::fireTransition(const Transition* transition, const NetState& state, NetState& result) const {
             assert(transition != NULL);
             assert(m_net.findTransition(transition->getName()) == transition);
-
+            
             if (!isFireable(transition, state))
                 throw FiringRuleException("Transition '" + transition->getName() + "' is not fireable");
-
-            NetState newState(state);
-            updateTokens(transition, newState);
-            updateSiblings(transition, newState);
-            updateSuccessors(transition, newState);
-            return newState;
+            
+            if (&result != &state)
+                result = state;
+            updateTokens(transition, result);
+            updateSiblings(transition, result);
+            updateSuccessors(transition, result);
         }
 
         bool FiringRule::canMakeTimeStep(const NetState& state) const {
@@ -166,33 +185,50 @@ namespace Tippi {
         }
 
         NetState FiringRule::makeTimeStep(const NetState& state) const {
+            NetState newState(state);
+            makeTimeStep(state, newState);
+            return newState;
+        }
+        
+        void FiringRule::makeTimeStep(const NetState& state, NetState& result) const {
             assert(canMakeTimeStep(state));
             
-            NetState newState(state);
+            if (&result != &state)
+                result = state;
             const Transition::List& transitions = m_net.getTransitions();
             Transition::List::const_iterator it, end;
             for (it = transitions.begin(), end = transitions.end(); it != end; ++it) {
                 Transition* transition = *it;
-                newState.makeTimeStep(1, transition);
+                result.makeTimeStep(1, transition);
             }
-            return newState;
         }
 
-        FiringRule::Closure FiringRule::buildClosure(const NetState& state, const StringList& labels) const {
-            return buildClosureRecurse(state, labels);
+        const LabelSet& FiringRule::getUnobservableLabels() {
+            static const LabelSet labels((Label()));
+            return labels;
+        }
+        
+        FiringRule::Closure FiringRule::buildClosure(const NetState& state, const LabelSet& labels) const {
+            Closure closure;
+            NetState next(state);
+            expandClosure(state, labels, closure, next);
+            return closure;
         }
 
-        FiringRule::Closure FiringRule::buildClosure(const Closure& closure, const StringList& labels) const {
+        FiringRule::Closure FiringRule::buildClosure(const Closure& closure, const LabelSet& labels) const {
             return buildClosure(closure.getStates(), labels);
         }
 
-        FiringRule::Closure FiringRule::buildClosure(const NetState::Set& states, const StringList& labels) const {
+        FiringRule::Closure FiringRule::buildClosure(const NetState::Set& states, const LabelSet& labels) const {
             Closure closure;
+            if (states.empty())
+                return closure;
+            
+            NetState next(*states.begin());
             NetState::Set::const_iterator it, end;
             for (it = states.begin(), end = states.end(); it != end && !closure.containsBoundViolation(); ++it) {
                 const NetState& state = *it;
-                const Closure stateClosure = buildClosureRecurse(state, labels);
-                closure.merge(stateClosure);
+                expandClosure(state, labels, closure, next);
             }
             return closure;
         }
@@ -274,30 +310,62 @@ namespace Tippi {
             }
         }
 
-        FiringRule::Closure FiringRule::buildClosureRecurse(const NetState& state, const StringList& labels) const {
-
-            Closure closure;
-            closure.addState(state);
+        /**
+         Adds all states to the given closure which are reachable from the given initial state by
+         firing transitions with the given labels. The states are visited in depth first order, and
+         the search stops as soon as an unbounded state is found. If a state is reached that is
+         already contained in the closure, the closure is marked as containing a loop.
+         
+         Successors are computed in the given scratch state, so only the states that are new to
+         the closure are copied.
+         */
+        void FiringRule::expandClosure(const NetState& initialState, const LabelSet& labels, Closure& closure, NetState& next) const {
+            typedef std::pair<NetState, size_t> Frame;
             
-            if (!state.isBounded(m_net)) {
+            if (!closure.addState(initialState)) {
+                closure.setContainsLoop();
+                return;
+            }
+            if (!initialState.isBounded(m_net)) {
                 closure.setContainsBoundViolation();
-                return closure;
+                return;
             }
             
-            const Transition::List fireableTransitions = getFireableTransitions(state);
-            Transition::List::const_iterator it, end;
-            for (it = fireableTransitions.begin(), end = fireableTransitions.end(); it != end && !closure.containsBoundViolation(); ++it) {
-                const Transition* transition = *it;
-                assert(state.checkPlaceEnabled(transition));
-                assert(isFireable(transition, state));
-                if (VectorUtils::contains(labels, transition->getLabel())) {
-                    const NetState next = fireTransition(transition, state);
-                    const Closure nextClosure = buildClosureRecurse(next, labels);
-                    closure.merge(nextClosure);
+            // The closure's states are stored in contiguous memory and may move when a state is
+            // added, so each frame keeps its own copy of its state. Popped frames are not
+            // destroyed so that their storage can be reused by the next push.
+            const Transition::List& transitions = m_net.getTransitions();
+            std::vector<Frame> stack;
+            stack.push_back(Frame(initialState, 0));
+            size_t depth = 1;
+            
+            while (depth > 0) {
+                Frame& frame = stack[depth - 1];
+                if (frame.second == transitions.size()) {
+                    --depth;
+                    continue;
+                }
+                
+                const NetState& state = frame.first;
+                const Transition* transition = transitions[frame.second++];
+                if (!labels.contains(transition->getLabel()) || !isFireable(transition, state))
+                    continue;
+                
+                fireTransition(transition, state, next);
+                if (!closure.addState(next)) {
+                    closure.setContainsLoop();
+                } else if (!next.isBounded(m_net)) {
+                    closure.setContainsBoundViolation();
+                    return;
+                } else if (depth < stack.size()) {
+                    stack[depth].first = next;
+                    stack[depth].second = 0;
+                    ++depth;
+                } else {
+                    stack.push_back(Frame(next, 0));
+                    ++depth;
                 }
             }
-            
-            return closure;
         }
     }
 }
@@ -22,6 +22,7 @@
 
 #include "IntervalNet.h"
 #include "IntervalNetState.h"
+#include "Label.h"
 
 namespace Tippi {
     namespace Interval {
@@ -39,6 +40,7 @@ namespace Tippi {
                 bool operator==(const Closure& rhs) const;
                 bool operator!=(const Closure& rhs) const;
                 int compare(const Closure& rhs) const;
+                HashUtils::Hash hash64(HashUtils::Hash seed = 0) const;
 
                 bool isEmpty() const;
                 bool containsState(const Interval::NetState& state) const;
@@ -64,11 +66,18 @@ namespace Tippi {
             Transition::List getFireableTransitions(const NetState& state) const;
             bool isFireable(const Transition* transition, const NetState& state) const;
             NetState fireTransition(const Transition* transition, const NetState& state) const;
+            void fireTransition(const Transition* transition, const NetState& state, NetState& result) const;
             bool canMakeTimeStep(const NetState& state) const;
             NetState makeTimeStep(const NetState& state) const;
-            Closure buildClosure(const NetState& state, const StringList& labels = StringList(1, "")) const;
-            Closure buildClosure(const Closure& closure, const StringList& labels = StringList(1, "")) const;
-            Closure buildClosure(const NetState::Set& states, const StringList& labels = StringList(1, "")) const;
+            void makeTimeStep(const NetState& state, NetState& result) const;
+            Closure buildClosure(const NetState& state, const LabelSet& labels = getUnobservableLabels()) const;
+            Closure buildClosure(const Closure& closure, const LabelSet& labels = getUnobservableLabels()) const;
+            Closure buildClosure(const NetState::Set& states, const LabelSet& labels = getUnobservableLabels()) const;
+            
+            /**
+             Returns the set that only contains the empty label of unobservable transitions.
+             */
+            static const LabelSet& getUnobservableLabels();
         private:
             void updateTokens(const Transition* transition, NetState& state) const;
             void consumeTokens(const Transition* transition, NetState& state) const;
@@ -78,7 +87,7 @@ namespace Tippi {
             void updateSuccessors(const Transition* transition, NetState& state) const;
             void resetPostset(const Place* place, NetState& state) const;
             void enablePostset(const Place* place, NetState& state) const;
-            Closure buildClosureRecurse(const NetState& state, const StringList& labels) const;
+            void expandClosure(const NetState& initialState, const LabelSet& labels, Closure& closure, NetState& next) const;
         };
     }
 }
@@ -76,6 +76,10 @@ namespace Tippi {
             return m_placeMarking.compare(placeMarking);
         }
 
+        HashUtils::Hash NetState::hash64(const HashUtils::Hash seed) const {
+            return m_timeMarking.hash64(m_placeMarking.hash64(seed));
+        }
+
         bool NetState::checkPlaceEnabled(const Transition* transition) const {
             return checkPlaceEnabled(transition, m_placeMarking);
         }
@@ -22,9 +22,10 @@
 
 #include "StringUtils.h"
 #include "IntervalNet.h"
+#include "CollectionUtils.h"
 #include "Marking.h"
 
-#include <set>
+#include <type_traits>
 
 namespace Tippi {
     namespace Interval {
@@ -35,7 +36,7 @@ namespace Tippi {
         class NetState {
         public:
             static const size_t DisabledTransition;
-            typedef std::set<NetState> Set;
+            typedef Utils::FlatSet<NetState> Set;
         private:
             Marking m_placeMarking;
             Marking m_timeMarking;
@@ -49,6 +50,7 @@ namespace Tippi {
             int compare(const NetState& rhs) const;
             int comparePlaceMarking(const NetState& rhs) const;
             int comparePlaceMarking(const Marking& placeMarking) const;
+            HashUtils::Hash hash64(HashUtils::Hash seed = 0) const;
 
             bool checkPlaceEnabled(const Transition* transition) const;
             bool isPlaceEnabled(const Transition* transition) const;
@@ -71,6 +73,9 @@ namespace Tippi {
         private:
             static bool checkPlaceEnabled(const Transition* transition, const Marking& placeMarking);
         };
+        
+        static_assert(std::is_nothrow_move_constructible<NetState::Set>::value,
+                      "growing a vector of state sets must move the sets instead of copying them");
     }
 }
 
@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntervalNetStubbornSet.h"
+
+#include <cassert>
+
+namespace Tippi {
+    namespace Interval {
+        StubbornSet::StubbornSet(const Net& net) :
+        m_net(net) {
+            const Transition::List& transitions = m_net.getTransitions();
+            m_candidates.resize(transitions.size(), false);
+            m_producers.resize(transitions.size());
+            
+            Transition::List::const_iterator it, end;
+            for (it = transitions.begin(), end = transitions.end(); it != end; ++it) {
+                const Transition* transition = *it;
+                if (isCandidate(transition)) {
+                    m_candidates[transition->getIndex()] = true;
+                    m_producers[transition->getIndex()] = findProducers(transition);
+                }
+            }
+        }
+        
+        const Transition* StubbornSet::findTransition(const NetState& state, const Transition::List& fireableTransitions) const {
+            Transition::List::const_iterator tIt, tEnd;
+            for (tIt = fireableTransitions.begin(), tEnd = fireableTransitions.end(); tIt != tEnd; ++tIt) {
+                const Transition* transition = *tIt;
+                if (!m_candidates[transition->getIndex()] || !isUrgent(transition, state))
+                    continue;
+                
+                bool producerEnabled = false;
+                const TransitionList& producers = m_producers[transition->getIndex()];
+                TransitionList::const_iterator pIt, pEnd;
+                for (pIt = producers.begin(), pEnd = producers.end(); pIt != pEnd && !producerEnabled; ++pIt) {
+                    const Transition* producer = *pIt;
+                    producerEnabled = state.isPlaceEnabled(producer);
+                }
+                
+                if (!producerEnabled)
+                    return transition;
+            }
+            return NULL;
+        }
+        
+        bool StubbornSet::isCandidate(const Transition* transition) const {
+            return (transition->getLabel().empty() &&
+                    transition->getInterval().isBounded() &&
+                    hasPrivatePreset(transition) &&
+                    !isEnabledInFinalMarking(transition));
+        }
+        
+        bool StubbornSet::hasPrivatePreset(const Transition* transition) const {
+            const Transition::IncomingList& incoming = transition->getIncoming();
+            if (incoming.empty())
+                return false;
+            
+            Transition::IncomingList::const_iterator it, end;
+            for (it = incoming.begin(), end = incoming.end(); it != end; ++it) {
+                const PlaceToTransition* arc = *it;
+                const Place* place = arc->getSource();
+                if (place->getOutgoing().size() != 1)
+                    return false;
+                assert(place->getOutgoing().front()->getTarget() == transition);
+            }
+            return true;
+        }
+        
+        bool StubbornSet::isEnabledInFinalMarking(const Transition* transition) const {
+            const Marking::List& finalMarkings = m_net.getFinalMarkings();
+            Marking::List::const_iterator mIt, mEnd;
+            for (mIt = finalMarkings.begin(), mEnd = finalMarkings.end(); mIt != mEnd; ++mIt) {
+                const Marking& marking = *mIt;
+                
+                bool enabled = true;
+                const Transition::IncomingList& incoming = transition->getIncoming();
+                Transition::IncomingList::const_iterator aIt, aEnd;
+                for (aIt = incoming.begin(), aEnd = incoming.end(); aIt != aEnd && enabled; ++aIt) {
+                    const PlaceToTransition* arc = *aIt;
+                    enabled = marking[arc->getSource()] >= arc->getMultiplicity();
+                }
+                
+                if (enabled)
+                    return true;
+            }
+            return false;
+        }
+        
+        StubbornSet::TransitionList StubbornSet::findProducers(const Transition* transition) const {
+            // Collects all transitions that can produce tokens in the preset of the given transition,
+            // either directly or by enabling another such transition.
+            TransitionList result;
+            std::vector<bool> visitedPlaces(m_net.getPlaces().size(), false);
+            std::vector<bool> visitedTransitions(m_net.getTransitions().size(), false);
+            visitedTransitions[transition->getIndex()] = true;
+            
+            std::vector<const Place*> places;
+            const Transition::IncomingList& incoming = transition->getIncoming();
+            Transition::IncomingList::const_iterator aIt, aEnd;
+            for (aIt = incoming.begin(), aEnd = incoming.end(); aIt != aEnd; ++aIt) {
+                const Place* place = (*aIt)->getSource();
+                if (!visitedPlaces[place->getIndex()]) {
+                    visitedPlaces[place->getIndex()] = true;
+                    places.push_back(place);
+                }
+            }
+            
+            while (!places.empty()) {
+                const Place* place = places.back();
+                places.pop_back();
+                
+                const Place::IncomingList& producingArcs = place->getIncoming();
+                Place::IncomingList::const_iterator pIt, pEnd;
+                for (pIt = producingArcs.begin(), pEnd = producingArcs.end(); pIt != pEnd; ++pIt) {
+                    const Transition* producer = (*pIt)->getSource();
+                    if (visitedTransitions[producer->getIndex()])
+                        continue;
+                    
+                    visitedTransitions[producer->getIndex()] = true;
+                    result.push_back(producer);
+                    
+                    const Transition::IncomingList& producerIncoming = producer->getIncoming();
+                    for (aIt = producerIncoming.begin(), aEnd = producerIncoming.end(); aIt != aEnd; ++aIt) {
+                        const Place* prePlace = (*aIt)->getSource();
+                        if (!visitedPlaces[prePlace->getIndex()]) {
+                            visitedPlaces[prePlace->getIndex()] = true;
+                            places.push_back(prePlace);
+                        }
+                    }
+                }
+            }
+            
+            return result;
+        }
+        
+        bool StubbornSet::isUrgent(const Transition* transition, const NetState& state) const {
+            assert(state.isPlaceEnabled(transition));
+            return !state.canMakeTimeStep(1, transition);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__IntervalNetStubbornSet__
+#define __Tippi__IntervalNetStubbornSet__
+
+#include "IntervalNet.h"
+#include "IntervalNetState.h"
+
+#include <vector>
+
+namespace Tippi {
+    namespace Interval {
+        /**
+         Computes singleton stubborn sets for partial order reduction of the state space of an
+         interval net.
+         
+         A fireable transition t forms a stubborn set on its own in a state s if firing t can be
+         commuted with every sequence of firings that can occur in s before t fires. Under interval
+         semantics, this requires the following conditions:
+         
+         - t is unobservable, so that postponing the firings of other transitions does not change
+           the observable behavior.
+         - t is urgent in s, i.e., its clock has reached the upper bound of its interval. Time
+           cannot pass before t fires, and firing sequences without time steps commute.
+         - t has a non-empty preset and is the only transition in the postset of each place in its
+           preset. Then no other transition can disable t or reset its clock.
+         - No transition that may eventually produce tokens in the preset of t is place enabled in
+           s. Otherwise, firing t first could hide a bound violation in the preset of t.
+         - t is not place enabled in any final marking. Then no state that is reached before t
+           fires is final.
+         
+         The first, third and last conditions depend only on the net and are precomputed.
+         */
+        class StubbornSet {
+        private:
+            typedef std::vector<const Transition*> TransitionList;
+            
+            const Net& m_net;
+            std::vector<bool> m_candidates;
+            std::vector<TransitionList> m_producers;
+        public:
+            StubbornSet(const Net& net);
+            
+            /**
+             Returns a transition from the given list of fireable transitions that forms a stubborn
+             set in the given state, or NULL if there is no such transition.
+             */
+            const Transition* findTransition(const NetState& state, const Transition::List& fireableTransitions) const;
+        private:
+            bool isCandidate(const Transition* transition) const;
+            bool hasPrivatePreset(const Transition* transition) const;
+            bool isEnabledInFinalMarking(const Transition* transition) const;
+            TransitionList findProducers(const Transition* transition) const;
+            bool isUrgent(const Transition* transition, const NetState& state) const;
+        };
+    }
+}
+
+#endif /* defined(__Tippi__IntervalNetStubbornSet__) */
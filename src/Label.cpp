@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Label.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Tippi {
+    namespace {
+        /**
+         The table is read far more often than it is written to, so readers share a lock and only
+         interning a new name takes it exclusively. The names are stored in a deque so that the
+         references returned by getName remain valid when new names are added.
+         */
+        class LabelTable {
+        private:
+            typedef std::map<String, size_t> IndexMap;
+            typedef std::shared_lock<std::shared_timed_mutex> ReadLock;
+            typedef std::unique_lock<std::shared_timed_mutex> WriteLock;
+            
+            mutable std::shared_timed_mutex m_mutex;
+            IndexMap m_indices;
+            std::deque<String> m_names;
+        public:
+            LabelTable() {
+                m_indices.insert(IndexMap::value_type("", 0));
+                m_names.push_back("");
+            }
+            
+            bool find(const String& name, size_t& index) const {
+                ReadLock lock(m_mutex);
+                const IndexMap::const_iterator it = m_indices.find(name);
+                if (it == m_indices.end())
+                    return false;
+                index = it->second;
+                return true;
+            }
+            
+            size_t intern(const String& name) {
+                size_t index;
+                if (find(name, index))
+                    return index;
+                
+                WriteLock lock(m_mutex);
+                IndexMap::iterator it = m_indices.lower_bound(name);
+                if (it != m_indices.end() && it->first == name)
+                    return it->second; // another thread interned it in the meantime
+                index = m_names.size();
+                m_names.push_back(name);
+                m_indices.insert(it, IndexMap::value_type(name, index));
+                return index;
+            }
+            
+            const String& getName(const size_t index) const {
+                ReadLock lock(m_mutex);
+                assert(index < m_names.size());
+                return m_names[index];
+            }
+            
+            size_t size() const {
+                ReadLock lock(m_mutex);
+                return m_names.size();
+            }
+        };
+        
+        LabelTable& labelTable() {
+            static LabelTable table;
+            return table;
+        }
+    }
+    
+    Label::Label() :
+    m_index(0) {}
+    
+    Label::Label(const String& name) :
+    m_index(name.empty() ? 0 : labelTable().intern(name)) {}
+    
+    Label::Label(const char* name) :
+    m_index(*name == 0 ? 0 : labelTable().intern(name)) {}
+    
+    size_t Label::getIndex() const {
+        return m_index;
+    }
+    
+    const String& Label::getName() const {
+        return labelTable().getName(m_index);
+    }
+    
+    bool Label::empty() const {
+        return m_index == 0;
+    }
+    
+    int Label::compare(const Label& other) const {
+        if (m_index == other.m_index)
+            return 0;
+        return getName().compare(other.getName());
+    }
+    
+    bool Label::find(const String& name, Label& label) {
+        return labelTable().find(name, label.m_index);
+    }
+    
+    size_t Label::count() {
+        return labelTable().size();
+    }
+    
+    std::ostream& operator<<(std::ostream& stream, const Label& label) {
+        stream << label.getName();
+        return stream;
+    }
+    
+    LabelSet::LabelSet() {}
+    
+    LabelSet::LabelSet(const Label& label) {
+        insert(label);
+    }
+    
+    void LabelSet::insert(const Label& label) {
+        if (label.getIndex() >= m_bits.size())
+            m_bits.resize(label.getIndex() + 1);
+        m_bits.set(label.getIndex());
+    }
+    
+    bool LabelSet::contains(const Label& label) const {
+        return label.getIndex() < m_bits.size() && m_bits.test(label.getIndex());
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__Label__
+#define __Tippi__Label__
+
+#include "BitSet.h"
+#include "StringUtils.h"
+
+#include <iostream>
+
+namespace Tippi {
+    /**
+     An action label of a transition or an automaton edge. Labels are interned in a global symbol
+     table, so each label is represented by a small index, and comparing two labels for equality
+     only compares their indices. The empty label, which denotes an unobservable action, always
+     has index 0.
+     
+     The symbol table may be accessed from several threads. Constructing a label from a name
+     interns the name if it is not yet known, so code which only queries labels should use find
+     instead, which never modifies the table.
+     */
+    class Label {
+    private:
+        size_t m_index;
+    public:
+        Label();
+        Label(const String& name);
+        Label(const char* name);
+        
+        size_t getIndex() const;
+        const String& getName() const;
+        bool empty() const;
+        
+        /**
+         Compares the names of this label and the given label lexicographically. In contrast to
+         operator<, which orders labels by their indices, the result of this method does not
+         depend on the order in which the labels were interned.
+         */
+        int compare(const Label& other) const;
+        
+        /**
+         Looks up the label with the given name without interning it.
+         
+         @param name the name of the label
+         @param label is set to the label if it exists
+         @return true if a label with the given name has been interned, and false otherwise
+         */
+        static bool find(const String& name, Label& label);
+        
+        /**
+         Returns the number of labels that have been interned so far.
+         */
+        static size_t count();
+    };
+    
+    inline bool operator==(const Label& lhs, const Label& rhs) {
+        return lhs.getIndex() == rhs.getIndex();
+    }
+    
+    inline bool operator!=(const Label& lhs, const Label& rhs) {
+        return lhs.getIndex() != rhs.getIndex();
+    }
+    
+    inline bool operator<(const Label& lhs, const Label& rhs) {
+        return lhs.getIndex() < rhs.getIndex();
+    }
+    
+    std::ostream& operator<<(std::ostream& stream, const Label& label);
+    
+    /**
+     A set of labels which is stored as a bit mask over the label indices.
+     */
+    class LabelSet {
+    private:
+        BitSet m_bits;
+    public:
+        LabelSet();
+        explicit LabelSet(const Label& label);
+        
+        void insert(const Label& label);
+        bool contains(const Label& label) const;
+    };
+}
+
+#endif /* defined(__Tippi__Label__) */
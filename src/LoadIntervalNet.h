@@ -30,7 +30,7 @@ namespace Tippi {
     }
     
     struct LoadIntervalNet {
-        typedef std::tr1::shared_ptr<Interval::Net> NetPtr;
+        typedef std::shared_ptr<Interval::Net> NetPtr;
         NetPtr operator()(std::istream& stream) const;
     };
 }
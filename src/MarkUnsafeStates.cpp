@@ -20,212 +20,238 @@
 #include "MarkUnsafeStates.h"
 
 namespace Tippi {
+    MarkUnsafeStates::Counters::Counters() :
+    serviceSuccessors(0),
+    safeServiceSuccessors(0),
+    unsafeServiceSuccessors(0),
+    safePartnerSuccessors(0),
+    unknownPartnerSuccessors(0),
+    safeTimeSuccessors(0),
+    unknownTimeSuccessors(0),
+    hasTimeEdge(false) {}
+    
     ClosureAutomaton::Ptr MarkUnsafeStates::operator()(ClosureAutomaton::Ptr automaton) const {
-        const ClosureAutomaton::ComponentList components = automaton->computeComponents();
-        ClosureAutomaton::ComponentList::const_iterator cIt = findDeadEndComponent(components);
-        while (cIt != components.end()) {
-            const ClosureAutomaton::Component& component = *cIt;
-            const ClosureAutomaton::Component::StateSet& states = component.getStates();
-            ClosureAutomaton::Component::StateSet::const_iterator sIt, sEnd;
-            for (sIt = states.begin(), sEnd = states.end(); sIt != sEnd; ++sIt) {
-                ClosureState* state = *sIt;
-                if (!state->isSafetyKnown())
-                    state->setSafe(false);
+        markDeadEndComponents(*automaton);
+        
+        const FrozenAutomaton frozen = automaton->freeze();
+        SafetyList safety(frozen.getStateCount(), Safety_Unknown);
+        initializeSafety(frozen, safety);
+        
+        IndexList worklist;
+        findInitialUnsafeStates(automaton->getStates(), frozen, safety, worklist);
+        
+        CounterList counters(frozen.getStateCount());
+        initializeCounters(frozen, safety, counters);
+        
+        while (!worklist.empty()) {
+            const size_t state = worklist.back();
+            worklist.pop_back();
+            
+            const FrozenAutomaton::EdgeRange incoming = frozen.getPredecessors(state);
+            for (size_t edge = incoming.first; edge < incoming.second; ++edge) {
+                const size_t predecessor = frozen.getPredecessor(edge);
+                if (safety[predecessor] == Safety_Unknown && determineSafety(frozen, predecessor, counters[predecessor], safety)) {
+                    updateCounters(frozen, predecessor, safety, counters);
+                    worklist.push_back(predecessor);
+                }
             }
-            cIt = findDeadEndComponent(components);
         }
-
-        const ClosureAutomaton::StateSet& states = automaton->getStates();
-        ClosureState::resetVisited(states.begin(), states.end());
-        
-        ClosureAutomaton::StateSet markedStates = findInitialUnsafeStates(states);
-        while (!markedStates.empty())
-            markedStates = markPredecessors(markedStates);
         
+        writeSafety(frozen, safety);
         return automaton;
     }
     
-    ClosureAutomaton::StateSet MarkUnsafeStates::findInitialUnsafeStates(const ClosureAutomaton::StateSet& states) const {
-        ClosureAutomaton::StateSet result;
-        
-        ClosureAutomaton::StateSet::iterator it, end;
-        for (it = states.begin(), end = states.end(); it != end; ++it) {
-            ClosureState* state = *it;
-            const Closure& closure = state->getClosure();
-            if (state->isDeadlock()) {
-                if (closure.containsBoundViolation() || closure.containsLoop()) {
+    void MarkUnsafeStates::markDeadEndComponents(const ClosureAutomaton& automaton) const {
+        // marking a component unsafe cannot turn another component into a dead end, so a single
+        // pass suffices
+        const ClosureAutomaton::Components components = automaton.computeComponents();
+        for (size_t component = 0; component < components.size(); ++component) {
+            if (isDeadEndComponent(components, component)) {
+                const ClosureAutomaton::Components::StateRange states = components.getStates(component);
+                ClosureAutomaton::Components::StateIterator sIt;
+                for (sIt = states.first; sIt != states.second; ++sIt) {
+                    ClosureState* state = *sIt;
                     state->setSafe(false);
-                    result.insert(state);
                 }
             }
         }
+    }
+    
+    bool MarkUnsafeStates::isDeadEndComponent(const ClosureAutomaton::Components& components, const size_t component) const {
+        const ClosureAutomaton::Components::StateRange states = components.getStates(component);
+        ClosureAutomaton::Components::StateIterator sIt;
+        for (sIt = states.first; sIt != states.second; ++sIt) {
+            const ClosureState* state = *sIt;
+            if (state->isSafetyKnown())
+                return false;
+            if (state->isFinal())
+                return false;
+            if (state->isEmpty())
+                return false;
+            if (state->isBoundViolation())
+                return false;
+            
+            const ClosureState::OutgoingList& outgoing = state->getOutgoing();
+            ClosureState::OutgoingList::const_iterator eIt, eEnd;
+            for (eIt = outgoing.begin(), eEnd = outgoing.end(); eIt != eEnd; ++eIt) {
+                ClosureEdge* edge = *eIt;
+                ClosureState* target = edge->getTarget();
+                if (!target->isEmpty() && !target->isBoundViolation() && !components.contains(component, target) && target->isSafetyKnown() && target->isSafe())
+                    return false;
+            }
+        }
         
-        return result;
+        return true;
     }
     
-    ClosureAutomaton::StateSet MarkUnsafeStates::markPredecessors(const ClosureAutomaton::StateSet& states) const {
-        ClosureAutomaton::StateSet result;
-
+    void MarkUnsafeStates::initializeSafety(const FrozenAutomaton& frozen, SafetyList& safety) const {
+        for (size_t state = 0; state < frozen.getStateCount(); ++state) {
+            if (frozen.hasFlag(state, FrozenFlags::Flag_SafetyKnown))
+                safety[state] = frozen.hasFlag(state, FrozenFlags::Flag_Safe) ? Safety_Safe : Safety_Unsafe;
+        }
+    }
+    
+    void MarkUnsafeStates::findInitialUnsafeStates(const ClosureAutomaton::StateSet& states, const FrozenAutomaton& frozen, SafetyList& safety, IndexList& unsafeStates) const {
+        // visit the states in the order of the automaton so that the propagation order does not
+        // depend on the numbering of the snapshot
         ClosureAutomaton::StateSet::const_iterator it, end;
         for (it = states.begin(), end = states.end(); it != end; ++it) {
-            ClosureAutomaton::State* state = *it;
-            markStates(result, findUndeterminedPredecessors(state));
+            const size_t state = frozen.getIndex(*it);
+            if (frozen.hasFlag(state, FrozenFlags::Flag_Deadlock)) {
+                if (frozen.hasFlag(state, FrozenFlags::Flag_BoundViolation) || frozen.hasFlag(state, FrozenFlags::Flag_ContainsLoop)) {
+                    safety[state] = Safety_Unsafe;
+                    unsafeStates.push_back(state);
+                }
+            }
         }
-        
-        return result;
     }
     
-    void MarkUnsafeStates::markStates(ClosureAutomaton::StateSet& markedStates, const ClosureAutomaton::StateSet& unmarkedStates) const {
-        ClosureAutomaton::StateSet::const_iterator it, end;
-        for (it = unmarkedStates.begin(), end = unmarkedStates.end(); it != end; ++it) {
-            ClosureAutomaton::State* predecessor = *it;
-            if (determineSafety(predecessor))
-                markedStates.insert(predecessor);
+    void MarkUnsafeStates::initializeCounters(const FrozenAutomaton& frozen, const SafetyList& safety, CounterList& counters) const {
+        for (size_t state = 0; state < frozen.getStateCount(); ++state) {
+            Counters& stateCounters = counters[state];
+            
+            const FrozenAutomaton::EdgeRange outgoing = frozen.getSuccessors(state);
+            for (size_t edge = outgoing.first; edge < outgoing.second; ++edge) {
+                const size_t target = frozen.getSuccessor(edge);
+                const bool known = safety[target] != Safety_Unknown;
+                const bool safe = safety[target] == Safety_Safe;
+                
+                switch (getKind(frozen, state, target, frozen.getSuccessorType(edge))) {
+                    case LoopEdge:
+                        stateCounters.hasTimeEdge = true;
+                        break;
+                    case ServiceEdge:
+                        ++stateCounters.serviceSuccessors;
+                        if (known) {
+                            if (safe)
+                                ++stateCounters.safeServiceSuccessors;
+                            else
+                                ++stateCounters.unsafeServiceSuccessors;
+                        }
+                        break;
+                    case PartnerEdge:
+                        if (!known)
+                            ++stateCounters.unknownPartnerSuccessors;
+                        else if (safe)
+                            ++stateCounters.safePartnerSuccessors;
+                        break;
+                    case TimeEdge:
+                        stateCounters.hasTimeEdge = true;
+                        if (!known)
+                            ++stateCounters.unknownTimeSuccessors;
+                        else if (safe)
+                            ++stateCounters.safeTimeSuccessors;
+                        break;
+                    default:
+                        break;
+                }
+            }
         }
     }
-
-    ClosureAutomaton::StateSet MarkUnsafeStates::findUndeterminedPredecessors(const ClosureAutomaton::State* state) const {
-        ClosureAutomaton::StateSet result;
+    
+    void MarkUnsafeStates::updateCounters(const FrozenAutomaton& frozen, const size_t state, const SafetyList& safety, CounterList& counters) const {
+        assert(safety[state] != Safety_Unknown);
+        const bool safe = safety[state] == Safety_Safe;
         
-        const ClosureAutomaton::Edge::List& incoming = state->getIncoming();
-        ClosureAutomaton::Edge::List::const_iterator it, end;
-        for (it = incoming.begin(), end = incoming.end(); it != end; ++it) {
-            ClosureAutomaton::Edge* edge = *it;
-            ClosureAutomaton::State* predecessor = edge->getSource();
-            if (!predecessor->isSafetyKnown())
-                result.insert(predecessor);
+        const FrozenAutomaton::EdgeRange incoming = frozen.getPredecessors(state);
+        for (size_t edge = incoming.first; edge < incoming.second; ++edge) {
+            const size_t source = frozen.getPredecessor(edge);
+            Counters& sourceCounters = counters[source];
+            
+            switch (getKind(frozen, source, state, frozen.getPredecessorType(edge))) {
+                case ServiceEdge:
+                    if (safe)
+                        ++sourceCounters.safeServiceSuccessors;
+                    else
+                        ++sourceCounters.unsafeServiceSuccessors;
+                    break;
+                case PartnerEdge:
+                    --sourceCounters.unknownPartnerSuccessors;
+                    if (safe)
+                        ++sourceCounters.safePartnerSuccessors;
+                    break;
+                case TimeEdge:
+                    --sourceCounters.unknownTimeSuccessors;
+                    if (safe)
+                        ++sourceCounters.safeTimeSuccessors;
+                    break;
+                default:
+                    break;
+            }
         }
-        return result;
     }
     
-    bool MarkUnsafeStates::determineSafety(ClosureAutomaton::State* state) const {
-        assert(!state->isSafetyKnown());
-        
-        static const size_t D = Interval::NetState::DisabledTransition;
+    bool MarkUnsafeStates::determineSafety(const FrozenAutomaton& frozen, const size_t state, const Counters& counters, SafetyList& safety) const {
+        assert(safety[state] == Safety_Unknown);
         
-        const Interval::NetState netState(Marking::createMarking(1, 0, 0, 1, 1, 0),
-                                    Marking::createMarking(1, 1, D, 0, 0, D));
-        Closure example;
-        example.addState(netState);
-        
-        const Closure& closure = state->getClosure();
-        
-        if (closure.containsBoundViolation() || closure.containsLoop()) {
-            state->setSafe(false);
+        if (frozen.hasFlag(state, FrozenFlags::Flag_BoundViolation) || frozen.hasFlag(state, FrozenFlags::Flag_ContainsLoop)) {
+            safety[state] = Safety_Unsafe;
             return true;
         }
         
-        if (state->isFinal()) {
-            state->setSafe(state->isStable());
+        if (frozen.isFinal(state)) {
+            safety[state] = frozen.hasFlag(state, FrozenFlags::Flag_Stable) ? Safety_Safe : Safety_Unsafe;
             return true;
         }
-
-        size_t serviceSuccessors = 0;
-        size_t safeServiceSuccessors = 0;
-        size_t unsafeServiceSuccessors = 0;
-        size_t partnerSuccessors = 0;
-        size_t safePartnerSuccessors = 0;
-        size_t unknownPartnerSuccessors = 0;
-        bool hasTimeEdge = false;
-        bool hasUnknownTimeSuccessor = false;
-        bool hasSafeTimeSuccessor = false;
-        
-        const ClosureEdge::List& outgoing = state->getOutgoing();
-        ClosureEdge::List::const_iterator it, end;
-        for (it = outgoing.begin(), end = outgoing.end();
-             it != end;
-             ++it) {
-            ClosureEdge* edge = *it;
-            ClosureState* successor = edge->getTarget();
-            
-            if (edge->isLoop()) {
-                hasTimeEdge = true;
-            } else {
-                if (!successor->isEmpty()) {
-                    if (edge->isServiceAction()) {
-                        ++serviceSuccessors;
-                        if (successor->isSafetyKnown()) {
-                            if (successor->isSafe())
-                                ++safeServiceSuccessors;
-                            else
-                                ++unsafeServiceSuccessors;
-                        }
-                    } else if (edge->isPartnerAction()) {
-                        ++partnerSuccessors;
-                        if (successor->isSafetyKnown()) {
-                            if (successor->isSafe())
-                                ++safePartnerSuccessors;
-                        } else {
-                            ++unknownPartnerSuccessors;
-                        }
-                    } else {
-                        hasTimeEdge = true;
-                        if (successor->isSafetyKnown()) {
-                            if (successor->isSafe())
-                                hasSafeTimeSuccessor = true;
-                        } else {
-                            hasUnknownTimeSuccessor = true;
-                        }
-                    }
-                }
-            }
-        }
         
-        if (unsafeServiceSuccessors > 0) {
-            state->setSafe(false);
+        if (counters.unsafeServiceSuccessors > 0) {
+            safety[state] = Safety_Unsafe;
             return true;
         }
         
-        if ((unknownPartnerSuccessors == 0 && safePartnerSuccessors == 0) &&
-            (hasTimeEdge && !hasUnknownTimeSuccessor && !hasSafeTimeSuccessor)) {
-            state->setSafe(false);
+        if ((counters.unknownPartnerSuccessors == 0 && counters.safePartnerSuccessors == 0) &&
+            (counters.hasTimeEdge && counters.unknownTimeSuccessors == 0 && counters.safeTimeSuccessors == 0)) {
+            safety[state] = Safety_Unsafe;
             return true;
         }
-
-        if (safeServiceSuccessors == serviceSuccessors) {
-            if (safePartnerSuccessors > 0 || !hasTimeEdge || hasSafeTimeSuccessor) {
-                state->setSafe(true);
+        
+        if (counters.safeServiceSuccessors == counters.serviceSuccessors) {
+            if (counters.safePartnerSuccessors > 0 || !counters.hasTimeEdge || counters.safeTimeSuccessors > 0) {
+                safety[state] = Safety_Safe;
                 return true;
             }
         }
         
         return false;
     }
-
-    ClosureAutomaton::ComponentList::const_iterator MarkUnsafeStates::findDeadEndComponent(const ClosureAutomaton::ComponentList& components) const {
-        ClosureAutomaton::ComponentList::const_iterator cIt, cEnd;
-        for (cIt = components.begin(), cEnd = components.end(); cIt != cEnd; ++cIt) {
-            const ClosureAutomaton::Component& component = *cIt;
-            if (isDeadEndComponent(component))
-                return cIt;
+    
+    void MarkUnsafeStates::writeSafety(const FrozenAutomaton& frozen, const SafetyList& safety) const {
+        for (size_t state = 0; state < frozen.getStateCount(); ++state) {
+            if (!frozen.hasFlag(state, FrozenFlags::Flag_SafetyKnown) && safety[state] != Safety_Unknown)
+                frozen.getState(state)->setSafe(safety[state] == Safety_Safe);
         }
-        return cEnd;
     }
-
-    bool MarkUnsafeStates::isDeadEndComponent(const ClosureAutomaton::Component& component) const {
-        const ClosureAutomaton::Component::StateSet& states = component.getStates();
-        typename ClosureAutomaton::Component::StateSet::const_iterator sIt, sEnd;
-        for (sIt = states.begin(), sEnd = states.end(); sIt != sEnd; ++sIt) {
-            const ClosureState* state = *sIt;
-            if (state->isSafetyKnown())
-                return false;
-            if (state->isFinal())
-                return false;
-            if (state->isEmpty())
-                return false;
-            if (state->isBoundViolation())
-                return false;
-            
-            const ClosureState::OutgoingList& outgoing = state->getOutgoing();
-            ClosureState::OutgoingList::const_iterator eIt, eEnd;
-            for (eIt = outgoing.begin(), eEnd = outgoing.end(); eIt != eEnd; ++eIt) {
-                ClosureEdge* edge = *eIt;
-                ClosureState* target = edge->getTarget();
-                if (!target->isEmpty() && !target->isBoundViolation() && states.count(target) == 0 && target->isSafetyKnown() && target->isSafe())
-                    return false;
-            }
-        }
-        
-        return true;
+    
+    MarkUnsafeStates::EdgeKind MarkUnsafeStates::getKind(const FrozenAutomaton& frozen, const size_t source, const size_t target, const unsigned char type) {
+        const ClosureEdge::EdgeType edgeType = static_cast<ClosureEdge::EdgeType>(type);
+        if (source == target)
+            return LoopEdge;
+        if (frozen.hasFlag(target, FrozenFlags::Flag_Empty))
+            return IgnoredEdge;
+        if (ClosureEdge::isServiceAction(edgeType))
+            return ServiceEdge;
+        if (ClosureEdge::isPartnerAction(edgeType))
+            return PartnerEdge;
+        return TimeEdge;
     }
 }
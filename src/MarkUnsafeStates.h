@@ -23,21 +23,68 @@
 #include "SharedPointer.h"
 #include "Closure.h"
 
+#include <vector>
+
 namespace Tippi {
+    /**
+     Determines the safety of the states of a closure automaton. First, every strongly connected
+     component which cannot leave itself towards a safe state is marked unsafe. Then, the deadlocks
+     that contain a bound violation or an inner livelock are marked unsafe, and the safety is
+     propagated backwards from them.
+     
+     The propagation keeps counters of the safe, unsafe and unknown successors of every state, so a
+     state is only revisited when the safety of one of its successors becomes known, and the
+     counters are updated in constant time per edge. It runs on a frozen snapshot of the automaton
+     and writes the safety of the states back once it is finished.
+     */
     class MarkUnsafeStates {
+    private:
+        struct Counters {
+            size_t serviceSuccessors;
+            size_t safeServiceSuccessors;
+            size_t unsafeServiceSuccessors;
+            size_t safePartnerSuccessors;
+            size_t unknownPartnerSuccessors;
+            size_t safeTimeSuccessors;
+            size_t unknownTimeSuccessors;
+            bool hasTimeEdge;
+            
+            Counters();
+        };
+        
+        typedef enum {
+            IgnoredEdge,
+            LoopEdge,
+            ServiceEdge,
+            PartnerEdge,
+            TimeEdge
+        } EdgeKind;
+        
+        typedef enum {
+            Safety_Unknown,
+            Safety_Safe,
+            Safety_Unsafe
+        } Safety;
+        
+        typedef ClosureAutomaton::FrozenAutomaton FrozenAutomaton;
+        typedef ClosureAutomaton::FrozenFlags FrozenFlags;
+        typedef std::vector<Counters> CounterList;
+        typedef std::vector<Safety> SafetyList;
+        typedef std::vector<size_t> IndexList;
     public:
         ClosureAutomaton::Ptr operator()(ClosureAutomaton::Ptr automaton) const;
     private:
-        ClosureAutomaton::StateSet findInitialUnsafeStates(const ClosureAutomaton::StateSet& states) const;
-        ClosureAutomaton::StateSet markPredecessors(const ClosureAutomaton::StateSet& unsafeStates) const;
+        void markDeadEndComponents(const ClosureAutomaton& automaton) const;
+        bool isDeadEndComponent(const ClosureAutomaton::Components& components, size_t component) const;
         
-        void markStates(ClosureAutomaton::StateSet& markedStates, const ClosureAutomaton::StateSet& unmarkedStates) const;
-        ClosureAutomaton::StateSet findUndeterminedPredecessors(const ClosureAutomaton::State* state) const;
+        void initializeSafety(const FrozenAutomaton& frozen, SafetyList& safety) const;
+        void findInitialUnsafeStates(const ClosureAutomaton::StateSet& states, const FrozenAutomaton& frozen, SafetyList& safety, IndexList& unsafeStates) const;
+        void initializeCounters(const FrozenAutomaton& frozen, const SafetyList& safety, CounterList& counters) const;
+        void updateCounters(const FrozenAutomaton& frozen, size_t state, const SafetyList& safety, CounterList& counters) const;
+        bool determineSafety(const FrozenAutomaton& frozen, size_t state, const Counters& counters, SafetyList& safety) const;
+        void writeSafety(const FrozenAutomaton& frozen, const SafetyList& safety) const;
         
-        bool determineSafety(ClosureAutomaton::State* state) const;
-
-        ClosureAutomaton::ComponentList::const_iterator findDeadEndComponent(const ClosureAutomaton::ComponentList& components) const;
-        bool isDeadEndComponent(const ClosureAutomaton::Component& component) const;
+        static EdgeKind getKind(const FrozenAutomaton& frozen, size_t source, size_t target, unsigned char type);
     };
 }
 
@@ -104,6 +104,13 @@ namespace Tippi {
         return 0;
     }
 
+    HashUtils::Hash Marking::hash64(const HashUtils::Hash seed) const {
+        HashUtils::Hash result = HashUtils::combine(seed, m_marking.size());
+        for (size_t i = 0; i < m_marking.size(); ++i)
+            result = HashUtils::combine(result, m_marking[i]);
+        return result;
+    }
+
     const size_t& Marking::operator[](const NetNode* node) const {
         assert(node != NULL);
         return (*this)[node->getIndex()];
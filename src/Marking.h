@@ -21,6 +21,7 @@
 #define __Tippi__PlaceMarking__
 
 #include "StringUtils.h"
+#include "HashUtils.h"
 
 #include <set>
 #include <vector>
@@ -47,6 +48,7 @@ namespace Tippi {
         bool operator<(const Marking& rhs) const;
         bool operator==(const Marking& rhs) const;
         int compare(const Marking& rhs) const;
+        HashUtils::Hash hash64(HashUtils::Hash seed = 0) const;
         
         const size_t& operator[](const NetNode* node) const;
         size_t& operator[](const NetNode* node);
@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MinimizeAutomaton.h"
+
+#include "Bisimulation.h"
+#include "Simulation.h"
+
+#include <vector>
+
+namespace Tippi {
+    struct ClosureStateClass {
+        size_t operator()(const ClosureState* state) const {
+            size_t result = 0;
+            if (state->isFinal())
+                result |= 1;
+            if (state->isEmpty())
+                result |= 2;
+            if (state->isBoundViolation())
+                result |= 4;
+            if (state->isSafetyKnown())
+                result |= state->isSafe() ? 8 : 16;
+            if (state->isReachable())
+                result |= 32;
+            return result;
+        }
+    };
+    
+    struct ClosureEdgeLabel {
+        LabelIndex::TypedLabel operator()(const ClosureEdge* edge) const {
+            return LabelIndex::TypedLabel(edge->getLabel(), static_cast<size_t>(edge->getType()));
+        }
+    };
+    
+    struct BehaviorStateClass {
+        size_t operator()(const BehaviorState* state) const {
+            size_t result = 0;
+            if (state->isFinal())
+                result |= 1;
+            if (state->isBoundViolation())
+                result |= 2;
+            return result;
+        }
+    };
+    
+    struct BehaviorEdgeLabel {
+        const Label& operator()(const BehaviorEdge* edge) const {
+            return edge->getLabel();
+        }
+    };
+    
+    template <class A, class StateClass, class EdgeLabel>
+    static void minimize(A& automaton, const StateClass& stateClass, const EdgeLabel& edgeLabel) {
+        typedef typename A::State State;
+        typedef std::pair<State*, State*> Merge;
+        
+        LabelIndex labels;
+        const LabeledGraph graph = LabeledGraph::build(automaton, labels, edgeLabel);
+        
+        // ids which do not belong to any state are put into a class of their own
+        std::vector<size_t> classes(graph.getStateCount(), 0);
+        const typename A::StateSet& states = automaton.getStates();
+        typename A::StateSet::const_iterator it, end;
+        for (it = states.begin(), end = states.end(); it != end; ++it) {
+            const State* state = *it;
+            classes[state->getId()] = stateClass(state) + 1;
+        }
+        
+        const Bisimulation bisimulation(graph, classes);
+        
+        std::vector<State*> representatives(bisimulation.getBlockCount(), NULL);
+        State* initialState = automaton.getInitialState();
+        if (initialState != NULL)
+            representatives[bisimulation.getBlock(initialState->getId())] = initialState;
+        
+        std::vector<Merge> merges;
+        for (it = states.begin(), end = states.end(); it != end; ++it) {
+            State* state = *it;
+            State*& representative = representatives[bisimulation.getBlock(state->getId())];
+            if (representative == NULL)
+                representative = state;
+            else if (representative != state)
+                merges.push_back(Merge(representative, state));
+        }
+        
+        typename std::vector<Merge>::const_iterator mIt, mEnd;
+        for (mIt = merges.begin(), mEnd = merges.end(); mIt != mEnd; ++mIt)
+            automaton.mergeStates(mIt->first, mIt->second);
+    }
+    
+    ClosureAutomaton::Ptr MinimizeAutomaton::operator()(ClosureAutomaton::Ptr automaton) const {
+        minimize(*automaton, ClosureStateClass(), ClosureEdgeLabel());
+        return automaton;
+    }
+    
+    Behavior::Ptr MinimizeAutomaton::operator()(Behavior::Ptr automaton) const {
+        minimize(*automaton, BehaviorStateClass(), BehaviorEdgeLabel());
+        return automaton;
+    }
+}
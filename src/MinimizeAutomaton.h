@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__MinimizeAutomaton__
+#define __Tippi__MinimizeAutomaton__
+
+#include "Behavior.h"
+#include "Closure.h"
+
+namespace Tippi {
+    /**
+     Replaces an automaton by its quotient with respect to the coarsest strong bisimulation. The
+     states of each equivalence class are merged into a single representative, which is the
+     initial state if it belongs to the class.
+     
+     States of a closure automaton are only merged if they agree in finality, emptiness, bound
+     violation, safety and reachability, and edges of a closure automaton are distinguished by their
+     labels and their types. States of a behavior are only merged if they agree in finality and
+     bound violation.
+     
+     Unobservable edges are treated like any other label, so states are only merged if they are
+     strongly bisimilar. Branching bisimulation, which would also merge states that only differ in
+     unobservable steps, is not implemented.
+     */
+    struct MinimizeAutomaton {
+    public:
+        ClosureAutomaton::Ptr operator()(ClosureAutomaton::Ptr automaton) const;
+        Behavior::Ptr operator()(Behavior::Ptr automaton) const;
+    };
+}
+
+#endif /* defined(__Tippi__MinimizeAutomaton__) */
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__ObjectPool__
+#define __Tippi__ObjectPool__
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Tippi {
+    /**
+     Provides storage for objects of a single type. The storage is allocated in chunks of
+     increasing size, and the storage of destroyed objects is reused for new objects. All chunks
+     are freed at once when the pool is destroyed.
+     
+     The pool does not construct or destroy objects by itself. Objects are constructed in the
+     storage returned by allocate using placement new, and they must be destroyed by calling
+     destroy. Objects that are still alive when the pool is destroyed are not destroyed.
+     */
+    template <typename T>
+    class ObjectPool {
+    private:
+        union Slot {
+            Slot* next;
+            char storage[sizeof(T)];
+            long double alignLongDouble;
+            void* alignPointer;
+            long alignLong;
+        };
+        
+        static const size_t MaxChunkSize = 4096;
+        
+        std::vector<Slot*> m_chunks;
+        size_t m_chunkSize;
+        size_t m_nextSlot;
+        Slot* m_freeList;
+        size_t m_size;
+    public:
+        /**
+         Creates a new pool. No storage is allocated until the first object is requested.
+         
+         @param chunkSize the number of objects in the first chunk
+         */
+        ObjectPool(const size_t chunkSize = 32) :
+        m_chunkSize(chunkSize > 0 ? chunkSize : 1),
+        m_nextSlot(m_chunkSize),
+        m_freeList(NULL),
+        m_size(0) {}
+        
+        ~ObjectPool() {
+            typename std::vector<Slot*>::const_iterator it, end;
+            for (it = m_chunks.begin(), end = m_chunks.end(); it != end; ++it)
+                delete [] *it;
+        }
+        
+        /**
+         Returns uninitialized storage for one object.
+         */
+        void* allocate() {
+            ++m_size;
+            if (m_freeList != NULL) {
+                Slot* slot = m_freeList;
+                m_freeList = slot->next;
+                return slot->storage;
+            }
+            
+            if (m_nextSlot == m_chunkSize) {
+                if (!m_chunks.empty() && m_chunkSize < MaxChunkSize)
+                    m_chunkSize *= 2;
+                m_chunks.push_back(new Slot[m_chunkSize]);
+                m_nextSlot = 0;
+            }
+            return m_chunks.back()[m_nextSlot++].storage;
+        }
+        
+        /**
+         Returns the storage of an object that was already destroyed to this pool.
+         */
+        void deallocate(T* object) {
+            assert(object != NULL);
+            assert(m_size > 0);
+            
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            slot->next = m_freeList;
+            m_freeList = slot;
+            --m_size;
+        }
+        
+        /**
+         Destroys the given object and returns its storage to this pool.
+         */
+        void destroy(T* object) {
+            if (object != NULL) {
+                object->~T();
+                deallocate(object);
+            }
+        }
+        
+        /**
+         Returns the number of objects whose storage has been allocated and not yet returned.
+         */
+        size_t size() const {
+            return m_size;
+        }
+    private:
+        ObjectPool(const ObjectPool& other);
+        ObjectPool& operator=(const ObjectPool& other);
+    };
+}
+
+#endif /* defined(__Tippi__ObjectPool__) */
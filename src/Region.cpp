@@ -21,15 +21,30 @@
 
 #include "Exceptions.h"
 
+#include <algorithm>
+
 namespace Tippi {
-    RegionEdge::RegionEdge(RegionState* source, RegionState* target, const String& label) :
+    RegionEdge::RegionEdge(RegionState* source, RegionState* target, const Label& label) :
     AutomatonEdge(source, target, label) {}
     
+    RegionState::Key::Key(const Region& i_region) :
+    fingerprint(RegionState::fingerprint(i_region)),
+    region(&i_region) {}
+    
+    RegionState::Key::Key(const Fingerprint i_fingerprint, const Region& i_region) :
+    fingerprint(i_fingerprint),
+    region(&i_region) {}
+    
     int RegionState::KeyCmp::operator() (const Key& lhs, const Key& rhs) const {
-        Region::const_iterator lit = lhs.begin();
-        const Region::const_iterator lend = rhs.end();
-        Region::const_iterator rit = rhs.begin();
-        const Region::const_iterator rend = rhs.end();
+        if (lhs.fingerprint < rhs.fingerprint)
+            return -1;
+        if (lhs.fingerprint > rhs.fingerprint)
+            return 1;
+        
+        Region::const_iterator lit = lhs.region->begin();
+        const Region::const_iterator lend = lhs.region->end();
+        Region::const_iterator rit = rhs.region->begin();
+        const Region::const_iterator rend = rhs.region->end();
         
         while (lit != lend && rit != rend) {
             const ClosureState* lstate = *lit;
@@ -51,56 +66,84 @@ namespace Tippi {
     }
 
     RegionState::RegionState(const Region& region) :
-    m_region(region) {}
+    m_region(region),
+    m_fingerprint(fingerprint(region)),
+    m_closureCount(region.size()) {}
     
-    const RegionState::Key& RegionState::getKey(const RegionState* state) {
-        return state->getRegion();
+    RegionState::RegionState(const Fingerprint fingerprint, const size_t closureCount) :
+    m_fingerprint(fingerprint),
+    m_closureCount(closureCount) {}
+    
+    const RegionState::Key RegionState::getKey(const RegionState* state) {
+        return Key(state->getFingerprint(), state->getRegion());
     }
 
     const Region& RegionState::getRegion() const {
         return m_region;
     }
+    
+    RegionState::Fingerprint RegionState::getFingerprint() const {
+        return m_fingerprint;
+    }
+    
+    size_t RegionState::getClosureCount() const {
+        return m_closureCount;
+    }
 
     bool RegionState::isEmpty() const {
-        return m_region.empty();
+        return m_closureCount == 0;
+    }
+    
+    RegionState::Fingerprint RegionState::fingerprint(const Closure& closure) {
+        if (closure.containsBoundViolation())
+            return 0;
+        
+        return closure.hash64();
+    }
+    
+    RegionState::Fingerprint RegionState::fingerprint(const Region& region) {
+        Fingerprint result = ~static_cast<Fingerprint>(0);
+        Region::const_iterator it, end;
+        for (it = region.begin(), end = region.end(); it != end; ++it) {
+            const ClosureState* state = *it;
+            result = std::min(result, fingerprint(state->getClosure()));
+        }
+        return result;
     }
     
     const RegionState* RegionAutomaton::findState(const Region& region) const {
-        RegionState query(region);
-        StateSet::const_iterator it = getStates().find(&query);
-        if (it == getStates().end())
-            return NULL;
-        return *it;
+        return Automaton<RegionState, RegionEdge>::findState(region);
     }
     
     const RegionState* RegionAutomaton::findRegion(const ClosureState* state) const {
-        const RegionMap::const_iterator it = m_regions.find(state);
-        if (it == m_regions.end())
+        const size_t id = state->getId();
+        if (id >= m_regions.size())
             return NULL;
-        return it->second;
+        return m_regions[id];
     }
 
     RegionState* RegionAutomaton::findRegion(const ClosureState* state) {
-        const RegionMap::iterator it = m_regions.find(state);
-        if (it == m_regions.end())
+        const size_t id = state->getId();
+        if (id >= m_regions.size())
             return NULL;
-        return it->second;
+        return m_regions[id];
     }
+    
     void RegionAutomaton::stateWasAdded(RegionState* state) {
         updateRegionMap(state);
     }
 
     void RegionAutomaton::updateRegionMap(RegionState* state) {
-        typedef std::pair<RegionMap::iterator, bool> InsertPos;
-
         const Region& region = state->getRegion();
         Region::const_iterator it, end;
         for (it = region.begin(), end = region.end(); it != end; ++it) {
             const ClosureState* clState = *it;
+            const size_t id = clState->getId();
             
-            const InsertPos insertPos = MapUtils::findInsertPos(m_regions, clState);
-            assert(!insertPos.second);
-            m_regions.insert(insertPos.first, std::make_pair(clState, state));
+            if (id >= m_regions.size())
+                m_regions.resize(id + 1, NULL);
+            assert(m_regions[id] == NULL);
+            m_regions[id] = state;
         }
     }
 }
@@ -21,6 +21,7 @@
 #define __Tippi__Region__
 
 #include "CollectionUtils.h"
+#include "HashUtils.h"
 #include "SharedPointer.h"
 #include "StringUtils.h"
 #include "Automaton.h"
@@ -36,33 +37,65 @@ namespace Tippi {
     public:
         typedef std::vector<RegionEdge*> List;
     public:
-        RegionEdge(RegionState* source, RegionState* target, const String& label);
+        RegionEdge(RegionState* source, RegionState* target, const Label& label);
     };
 
     typedef ClosureAutomaton::StateSet Region;
     
+    /**
+     A region of a closure automaton. A region either stores its closure states, or, if the closure
+     states were discarded after the region was built, only the number of its closure states. In
+     both cases, a region is identified by its fingerprint, which is the smallest fingerprint of its
+     closures.
+     */
     class RegionState : public AutomatonState<RegionState, RegionEdge> {
     public:
-        typedef Region Key;
+        typedef HashUtils::Hash Fingerprint;
+        
+        struct Key {
+            Fingerprint fingerprint;
+            const Region* region;
+            
+            Key(const Region& i_region);
+            Key(Fingerprint i_fingerprint, const Region& i_region);
+        };
         struct KeyCmp {
             ClosureState::KeyCmp m_cmp;
             int operator() (const Key& lhs, const Key& rhs) const;
         };
     private:
         Region m_region;
+        Fingerprint m_fingerprint;
+        size_t m_closureCount;
     public:
         RegionState(const Region& region);
-        static const Key& getKey(const RegionState* state);
+        RegionState(Fingerprint fingerprint, size_t closureCount);
+        static const Key getKey(const RegionState* state);
 
         const Region& getRegion() const;
+        Fingerprint getFingerprint() const;
+        size_t getClosureCount() const;
         bool isEmpty() const;
+        
+        /**
+         Returns a 64 bit fingerprint of the given closure, which is computed from the markings of
+         its states independently of the width of size_t. Equal closures have equal fingerprints,
+         and different closures have different fingerprints with high probability. All closures
+         which contain a bound violation have the same fingerprint, since the closure automaton
+         represents them by a single state.
+         */
+        static Fingerprint fingerprint(const Closure& closure);
+        static Fingerprint fingerprint(const Region& region);
     };
     
     class RegionAutomaton : public Automaton<RegionState, RegionEdge> {
     public:
-        typedef std::tr1::shared_ptr<RegionAutomaton> Ptr;
+        typedef std::shared_ptr<RegionAutomaton> Ptr;
     private:
-        typedef std::map<const ClosureState*, RegionState*> RegionMap;
+        /**
+         Maps the id of each closure state to the region that contains it, or NULL.
+         */
+        typedef std::vector<RegionState*> RegionMap;
         RegionMap m_regions;
     public:
         const RegionState* findState(const Region& region) const;
@@ -21,7 +21,7 @@
 
 namespace Tippi {
     ClosureAutomaton::Ptr RemoveUnreachableStates::operator()(ClosureAutomaton::Ptr automaton) const {
-        const ClosureAutomaton::StateSet unreachable = automaton->findUnreachableStates();
+        const ClosureAutomaton::StateList unreachable = automaton->findUnreachableStates();
         automaton->deleteStates(unreachable.begin(), unreachable.end());
         
         /*
@@ -23,6 +23,7 @@
 #include "GraphAlgorithms.h"
 
 #include <iomanip>
+#include <iterator>
 
 namespace Tippi {
     RenderClosureAutomaton::RenderClosureAutomaton(std::ostream& stream, const bool showEmptyState, const bool showSCCs) :
@@ -31,27 +32,27 @@ namespace Tippi {
     m_showSCCs(showSCCs) {}
 
     void RenderClosureAutomaton::operator()(const ClosureAutomaton* automaton) {
+        (*this)(ClosureAutomaton::View(*automaton));
+    }
+    
+    void RenderClosureAutomaton::operator()(const ClosureAutomaton::View& automaton) {
         m_stream << "digraph {" << std::endl;
         
-        if (m_showSCCs && automaton->getInitialState() != NULL) {
-            const ClosureAutomaton::ComponentList& components = automaton->computeComponents();
-            size_t index = 0;
-            ClosureAutomaton::ComponentList::const_iterator cIt, cEnd;
-            for (cIt = components.begin(), cEnd = components.end(); cIt != cEnd; ++cIt) {
-                const ClosureAutomaton::Component& component = *cIt;
-                printComponent(component, ++index);
-            }
+        if (m_showSCCs && automaton.getInitialState() != NULL) {
+            const ClosureAutomaton::Components components = automaton.computeComponents();
+            for (size_t component = 0; component < components.size(); ++component)
+                printComponent(components.getStates(component), component + 1);
         } else {
-            const ClosureAutomaton::StateSet& states = automaton->getStates();
-            ClosureAutomaton::StateSet::const_iterator it, end;
+            const ClosureAutomaton::View::StateList states = automaton.getStates();
+            ClosureAutomaton::View::StateList::const_iterator it, end;
             for (it = states.begin(), end = states.end(); it != end; ++it) {
                 const ClosureState* state = *it;
                 printState(state);
             }
         }
         
-        const ClosureAutomaton::EdgeSet edges = automaton->getEdges();
-        ClosureAutomaton::EdgeSet::const_iterator eIt, eEnd;
+        const ClosureAutomaton::EdgeList edges = automaton.getSortedEdges();
+        ClosureAutomaton::EdgeList::const_iterator eIt, eEnd;
         for (eIt = edges.begin(), eEnd = edges.end(); eIt != eEnd; ++eIt) {
             const ClosureEdge* edge = *eIt;
             printEdge(edge);
@@ -60,14 +61,13 @@ namespace Tippi {
         m_stream << "}" << std::endl;
     }
 
-    void RenderClosureAutomaton::printComponent(const ClosureAutomaton::Component& component, const size_t index) {
+    void RenderClosureAutomaton::printComponent(const ClosureAutomaton::Components::StateRange& states, const size_t index) {
         
-        if (m_showEmptyState || !containsOnlyEmptyState(component)) {
+        if (m_showEmptyState || !containsOnlyEmptyState(states)) {
             m_stream << "subgraph cluster_" << index << " {" << std::endl;
             
-            const ClosureAutomaton::Component::StateSet& states = component.getStates();
-            ClosureAutomaton::Component::StateSet::const_iterator sIt, sEnd;
-            for (sIt = states.begin(), sEnd = states.end(); sIt != sEnd; ++sIt) {
+            ClosureAutomaton::Components::StateIterator sIt;
+            for (sIt = states.first; sIt != states.second; ++sIt) {
                 const ClosureState* state = *sIt;
                 printState(state);
             }
@@ -76,11 +76,10 @@ namespace Tippi {
         }
     }
     
-    bool RenderClosureAutomaton::containsOnlyEmptyState(const ClosureAutomaton::Component& component) const {
-        const ClosureAutomaton::Component::StateSet& states = component.getStates();
-        if (states.size() != 1)
+    bool RenderClosureAutomaton::containsOnlyEmptyState(const ClosureAutomaton::Components::StateRange& states) const {
+        if (std::distance(states.first, states.second) != 1)
             return false;
-        const ClosureState* state = *states.begin();
+        const ClosureState* state = *states.first;
         return state->isEmpty();
     }
 
@@ -135,7 +134,7 @@ namespace Tippi {
             (!source->isEmpty() &&
              !target->isEmpty())) {
                 m_stream << source->getId() << " -> " << target->getId() << " [";
-                printAttribute("label", edge->getLabel());
+                printAttribute("label", edge->getLabel().getName());
                 
                 if (source->isEmpty() || target->isEmpty()) {
                     m_stream << ",";
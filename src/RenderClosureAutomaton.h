@@ -36,9 +36,10 @@ namespace Tippi {
     public:
         RenderClosureAutomaton(std::ostream& stream, bool showEmptyState, bool showSCCs);
         void operator()(const ClosureAutomaton* automaton);
+        void operator()(const ClosureAutomaton::View& automaton);
     private:
-        void printComponent(const ClosureAutomaton::Component& component, size_t index);
-        bool containsOnlyEmptyState(const ClosureAutomaton::Component& component) const;
+        void printComponent(const ClosureAutomaton::Components::StateRange& states, size_t index);
+        bool containsOnlyEmptyState(const ClosureAutomaton::Components::StateRange& states) const;
         
         void printState(const ClosureState* state);
         void printEdge(const ClosureEdge* edge);
@@ -26,6 +26,7 @@
 #include "IntervalNet.h"
 #include "NetNode.h"
 
+#include <algorithm>
 #include <map>
 
 namespace Tippi {
@@ -87,6 +88,20 @@ namespace Tippi {
         }
     };
     
+    /**
+     Maps places to even and transitions to odd indices so that both can be marked in the same
+     visited set.
+     */
+    struct NetNodeKey {
+        size_t operator()(const Interval::Place* place) const {
+            return 2 * place->getIndex();
+        }
+        
+        size_t operator()(const Interval::Transition* transition) const {
+            return 2 * transition->getIndex() + 1;
+        }
+    };
+    
     void RenderIntervalNet::operator()(const NetPtr net, std::ostream& stream) {
         stream << "digraph {" << std::endl;
 
@@ -94,11 +109,11 @@ namespace Tippi {
         
         const Interval::Place::List& places = net->getPlaces();
         const Interval::Transition::List& transitions = net->getTransitions();
-        Interval::Place::resetVisited(places.begin(), places.end());
-        Interval::Transition::resetVisited(transitions.begin(), transitions.end());
 
-        BreadthFirst<IntervalNetVisitor, IntervalNetVisitor> visitPlaces(visitor, visitor);
-        BreadthFirst<IntervalNetVisitor, IntervalNetVisitor> visitTransitions(visitor, visitor);
+        typedef VisitedSet<NetNodeKey> Visited;
+        Visited visited(2 * std::max(places.size(), transitions.size()));
+        BreadthFirst<IntervalNetVisitor, IntervalNetVisitor, Visited> visitPlaces(visitor, visitor, visited);
+        BreadthFirst<IntervalNetVisitor, IntervalNetVisitor, Visited> visitTransitions(visitor, visitor, visited);
         
         Interval::Place::List::const_iterator pIt, pEnd;
         for (pIt = places.begin(), pEnd = places.end(); pIt != pEnd; ++pIt) {
@@ -31,7 +31,7 @@ namespace Tippi {
     }
     
     struct RenderIntervalNet {
-        typedef std::tr1::shared_ptr<Interval::Net> NetPtr;
+        typedef std::shared_ptr<Interval::Net> NetPtr;
         void operator()(const NetPtr net, std::ostream& stream);
         String operator()(const NetPtr net);
     };
@@ -20,11 +20,7 @@
 #ifndef TrenchBroom_SharedPointer_h
 #define TrenchBroom_SharedPointer_h
 
-#if defined _WIN32
 #include <memory>
-#else
-#include <tr1/memory>
-#endif
 
 template <typename T>
 struct ArrayDeleter {
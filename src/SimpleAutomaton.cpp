@@ -22,7 +22,7 @@
 #include <cassert>
 
 namespace Tippi {
-    SimpleAutomatonEdge::SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target, const String& label) :
+    SimpleAutomatonEdge::SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target, const Label& label) :
     AutomatonEdge(source, target, label) {}
 
     SimpleAutomatonEdge::SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target) :
@@ -32,7 +32,7 @@ namespace Tippi {
     public:
         typedef std::vector<SimpleAutomatonEdge*> List;
     public:
-        SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target, const String& label);
+        SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target, const Label& label);
         SimpleAutomatonEdge(SimpleAutomatonState* source, SimpleAutomatonState* target);
     };
     
@@ -53,7 +53,7 @@ namespace Tippi {
     
     class SimpleAutomaton : public Automaton<SimpleAutomatonState, SimpleAutomatonEdge> {
     public:
-        typedef std::tr1::shared_ptr<SimpleAutomaton> Ptr;
+        typedef std::shared_ptr<SimpleAutomaton> Ptr;
     };
 }
 
@@ -0,0 +1,608 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Simulation.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Tippi {
+    const size_t LabelIndex::None;
+    
+    size_t LabelIndex::getIndex(const String& label) {
+        const Map::iterator it = m_indices.lower_bound(label);
+        if (it != m_indices.end() && it->first == label)
+            return it->second;
+        
+        const size_t index = m_labels.size();
+        m_indices.insert(it, std::make_pair(label, index));
+        m_labels.push_back(label);
+        return index;
+    }
+    
+    size_t LabelIndex::getIndex(const Label& label) {
+        if (label.getIndex() >= m_labelIndices.size())
+            m_labelIndices.resize(label.getIndex() + 1, None);
+        size_t& index = m_labelIndices[label.getIndex()];
+        if (index == None)
+            index = getIndex(label.getName());
+        return index;
+    }
+    
+    size_t LabelIndex::getIndex(const TypedLabel& label) {
+        const size_t type = label.second;
+        if (type >= m_typedLabelIndices.size())
+            m_typedLabelIndices.resize(type + 1);
+        
+        std::vector<size_t>& indices = m_typedLabelIndices[type];
+        if (label.first.getIndex() >= indices.size())
+            indices.resize(label.first.getIndex() + 1, None);
+        size_t& index = indices[label.first.getIndex()];
+        if (index == None) {
+            index = m_labels.size();
+            m_labels.push_back(label.first.getName());
+        }
+        return index;
+    }
+    
+    const String& LabelIndex::getLabel(const size_t index) const {
+        assert(index < m_labels.size());
+        return m_labels[index];
+    }
+    
+    size_t LabelIndex::size() const {
+        return m_labels.size();
+    }
+    
+    LabeledGraph::Transition::Transition(const size_t i_label, const size_t i_state) :
+    label(i_label),
+    state(i_state) {}
+    
+    bool LabeledGraph::Transition::operator<(const Transition& rhs) const {
+        if (label < rhs.label)
+            return true;
+        if (label > rhs.label)
+            return false;
+        return state < rhs.state;
+    }
+    
+    bool LabeledGraph::Transition::operator==(const Transition& rhs) const {
+        return label == rhs.label && state == rhs.state;
+    }
+    
+    LabeledGraph::LabeledGraph(const size_t stateCount) :
+    m_stateCount(stateCount),
+    m_labelCount(0) {}
+    
+    void LabeledGraph::addEdge(const size_t source, const size_t label, const size_t target) {
+        assert(source < m_stateCount);
+        assert(target < m_stateCount);
+        
+        Edge edge;
+        edge.source = source;
+        edge.label = label;
+        edge.target = target;
+        m_edges.push_back(edge);
+        m_labelCount = std::max(m_labelCount, label + 1);
+    }
+    
+    void LabeledGraph::freeze() {
+        buildTransitions(m_stateCount, m_edges, true, m_successorOffsets, m_successors);
+        buildTransitions(m_stateCount, m_edges, false, m_predecessorOffsets, m_predecessors);
+        std::vector<Edge>().swap(m_edges);
+    }
+    
+    size_t LabeledGraph::getStateCount() const {
+        return m_stateCount;
+    }
+    
+    size_t LabeledGraph::getLabelCount() const {
+        return m_labelCount;
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getSuccessors(const size_t state) const {
+        return getRange(m_successorOffsets, m_successors, state);
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getSuccessors(const size_t state, const size_t label) const {
+        return getRange(m_successorOffsets, m_successors, state, label);
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getPredecessors(const size_t state) const {
+        return getRange(m_predecessorOffsets, m_predecessors, state);
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getPredecessors(const size_t state, const size_t label) const {
+        return getRange(m_predecessorOffsets, m_predecessors, state, label);
+    }
+    
+    void LabeledGraph::buildTransitions(const size_t stateCount, const std::vector<Edge>& edges, const bool forward, std::vector<size_t>& offsets, TransitionList& transitions) {
+        // counting sort by the source (or target) state, then sort the transitions of each state
+        offsets.assign(stateCount + 1, 0);
+        std::vector<Edge>::const_iterator it, end;
+        for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+            const Edge& edge = *it;
+            ++offsets[(forward ? edge.source : edge.target) + 1];
+        }
+        for (size_t i = 0; i < stateCount; ++i)
+            offsets[i + 1] += offsets[i];
+        
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        transitions.assign(edges.size(), Transition(0, 0));
+        for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+            const Edge& edge = *it;
+            if (forward)
+                transitions[next[edge.source]++] = Transition(edge.label, edge.target);
+            else
+                transitions[next[edge.target]++] = Transition(edge.label, edge.source);
+        }
+        
+        for (size_t i = 0; i < stateCount; ++i)
+            std::sort(transitions.begin() + offsets[i], transitions.begin() + offsets[i + 1]);
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getRange(const std::vector<size_t>& offsets, const TransitionList& transitions, const size_t state) {
+        assert(state + 1 < offsets.size());
+        return std::make_pair(transitions.begin() + offsets[state], transitions.begin() + offsets[state + 1]);
+    }
+    
+    LabeledGraph::TransitionRange LabeledGraph::getRange(const std::vector<size_t>& offsets, const TransitionList& transitions, const size_t state, const size_t label) {
+        const TransitionRange range = getRange(offsets, transitions, state);
+        const TransitionIterator first = std::lower_bound(range.first, range.second, Transition(label, 0));
+        TransitionIterator last = first;
+        while (last != range.second && last->label == label)
+            ++last;
+        return std::make_pair(first, last);
+    }
+    
+    static const size_t Unvisited = static_cast<size_t>(-1);
+    
+    TauComponents::TauComponents(const LabeledGraph& graph, const size_t tau) :
+    m_componentOf(graph.getStateCount(), Unvisited) {
+        // iterative version of Tarjan's algorithm, restricted to tau transitions
+        const size_t stateCount = graph.getStateCount();
+        IndexList index(stateCount, Unvisited);
+        IndexList lowLink(stateCount, 0);
+        IndexList stack;
+        
+        typedef std::pair<size_t, LabeledGraph::TransitionIterator> Frame;
+        std::vector<Frame> callStack;
+        size_t nextIndex = 0;
+        
+        m_memberOffsets.push_back(0);
+        
+        for (size_t root = 0; root < stateCount; ++root) {
+            if (index[root] != Unvisited)
+                continue;
+            
+            index[root] = lowLink[root] = nextIndex++;
+            stack.push_back(root);
+            callStack.push_back(Frame(root, graph.getSuccessors(root, tau).first));
+            
+            while (!callStack.empty()) {
+                Frame& frame = callStack.back();
+                const size_t state = frame.first;
+                const LabeledGraph::TransitionIterator end = graph.getSuccessors(state, tau).second;
+                
+                if (frame.second != end) {
+                    const size_t successor = frame.second->state;
+                    ++frame.second;
+                    
+                    if (index[successor] == Unvisited) {
+                        index[successor] = lowLink[successor] = nextIndex++;
+                        stack.push_back(successor);
+                        callStack.push_back(Frame(successor, graph.getSuccessors(successor, tau).first));
+                    } else if (m_componentOf[successor] == Unvisited) {
+                        // the successor is still on the stack
+                        lowLink[state] = std::min(lowLink[state], index[successor]);
+                    }
+                } else {
+                    callStack.pop_back();
+                    if (!callStack.empty()) {
+                        const size_t parent = callStack.back().first;
+                        lowLink[parent] = std::min(lowLink[parent], lowLink[state]);
+                    }
+                    if (lowLink[state] == index[state])
+                        addComponent(stack, state);
+                }
+            }
+        }
+    }
+    
+    size_t TauComponents::getComponentCount() const {
+        return m_memberOffsets.size() - 1;
+    }
+    
+    size_t TauComponents::getComponent(const size_t state) const {
+        assert(state < m_componentOf.size());
+        return m_componentOf[state];
+    }
+    
+    TauComponents::IndexRange TauComponents::getMembers(const size_t component) const {
+        return getRange(m_memberOffsets, m_members, component);
+    }
+    
+    LabeledGraph TauComponents::buildComponentGraph(const LabeledGraph& graph, const size_t tau) const {
+        LabeledGraph result(getComponentCount());
+        for (size_t state = 0; state < graph.getStateCount(); ++state) {
+            const size_t component = getComponent(state);
+            const LabeledGraph::TransitionRange successors = graph.getSuccessors(state);
+            LabeledGraph::TransitionIterator it;
+            for (it = successors.first; it != successors.second; ++it) {
+                const size_t successorComponent = getComponent(it->state);
+                if (it->label != tau || successorComponent != component)
+                    result.addEdge(component, it->label, successorComponent);
+            }
+        }
+        result.freeze();
+        return result;
+    }
+    
+    TauComponents::IndexRange TauComponents::getRange(const IndexList& offsets, const IndexList& values, const size_t index) {
+        assert(index + 1 < offsets.size());
+        return std::make_pair(values.begin() + offsets[index], values.begin() + offsets[index + 1]);
+    }
+    
+    void TauComponents::addComponent(IndexList& stack, const size_t root) {
+        // Components are completed in reverse topological order.
+        const size_t component = getComponentCount();
+        size_t state;
+        do {
+            state = stack.back();
+            stack.pop_back();
+            m_componentOf[state] = component;
+            m_members.push_back(state);
+        } while (state != root);
+        m_memberOffsets.push_back(m_members.size());
+    }
+    
+    TauClosure::TauClosure(const LabeledGraph& graph, const size_t tau) :
+    TauComponents(graph, tau) {
+        // the closures of all successor components are known because they have smaller indices
+        m_closureOffsets.push_back(0);
+        
+        IndexList closure;
+        for (size_t component = 0; component < getComponentCount(); ++component) {
+            closure.clear();
+            closure.push_back(component);
+            
+            const IndexRange members = getMembers(component);
+            IndexIterator mIt;
+            for (mIt = members.first; mIt != members.second; ++mIt) {
+                const LabeledGraph::TransitionRange successors = graph.getSuccessors(*mIt, tau);
+                LabeledGraph::TransitionIterator tIt;
+                for (tIt = successors.first; tIt != successors.second; ++tIt) {
+                    const size_t successorComponent = getComponent(tIt->state);
+                    if (successorComponent != component) {
+                        assert(successorComponent < component);
+                        const IndexRange successorClosure = getClosure(successorComponent);
+                        closure.insert(closure.end(), successorClosure.first, successorClosure.second);
+                    }
+                }
+            }
+            
+            std::sort(closure.begin(), closure.end());
+            closure.erase(std::unique(closure.begin(), closure.end()), closure.end());
+            m_closures.insert(m_closures.end(), closure.begin(), closure.end());
+            m_closureOffsets.push_back(m_closures.size());
+        }
+    }
+    
+    TauClosure::IndexRange TauClosure::getClosure(const size_t component) const {
+        return getRange(m_closureOffsets, m_closures, component);
+    }
+    
+    const size_t Simulation::None;
+    
+    Simulation::Loss::Loss(const size_t i_label, const size_t i_simulatorState, const size_t i_simulateeState) :
+    label(i_label),
+    simulatorState(i_simulatorState),
+    simulateeState(i_simulateeState) {}
+    
+    Simulation::Simulation(const LabeledGraph& simulator, const LabeledGraph& simulatee) :
+    m_tau(None),
+    m_componentGraph(0),
+    m_simulator(simulator),
+    m_simulatee(simulatee),
+    m_relation(m_simulatee.getStateCount(), BitSet(m_simulator.getStateCount())) {
+        PairList removed;
+        initialize(removed);
+        refine(removed);
+    }
+    
+    Simulation::Simulation(const LabeledGraph& simulator, const LabeledGraph& simulatee, const size_t tau) :
+    m_tau(tau),
+    m_componentGraph(buildComponentGraph(simulator, tau, m_componentOf)),
+    m_simulator(m_componentGraph),
+    m_simulatee(simulatee),
+    m_relation(m_simulatee.getStateCount(), BitSet(m_simulator.getStateCount())) {
+        PairList removed;
+        initialize(removed);
+        refine(removed);
+    }
+    
+    bool Simulation::simulates(const size_t simulatorState, const size_t simulateeState) const {
+        assert(simulateeState < m_simulatee.getStateCount());
+        if (m_tau == None) {
+            assert(simulatorState < m_simulator.getStateCount());
+            return m_relation[simulateeState].test(simulatorState);
+        }
+        
+        assert(simulatorState < m_componentOf.size());
+        return m_relation[simulateeState].test(m_componentOf[simulatorState]);
+    }
+    
+    LabeledGraph Simulation::buildComponentGraph(const LabeledGraph& simulator, const size_t tau, IndexList& componentOf) {
+        const TauComponents components(simulator, tau);
+        componentOf.resize(simulator.getStateCount());
+        for (size_t state = 0; state < simulator.getStateCount(); ++state)
+            componentOf[state] = components.getComponent(state);
+        return components.buildComponentGraph(simulator, tau);
+    }
+    
+    void Simulation::initialize(PairList& removed) {
+        const size_t simulatorCount = m_simulator.getStateCount();
+        const size_t simulateeCount = m_simulatee.getStateCount();
+        const size_t labelCount = std::max(std::max(m_simulator.getLabelCount(), m_simulatee.getLabelCount()),
+                                           m_tau == None ? 0 : m_tau + 1);
+        
+        // The simulator states which have at least one outgoing transition with each label. For
+        // weak simulation, a state also has the labels of its tau successors, which have smaller
+        // indices in the component graph.
+        std::vector<BitSet> hasLabel(labelCount, BitSet(simulatorCount));
+        for (size_t a = 0; a < simulatorCount; ++a) {
+            const LabeledGraph::TransitionRange successors = m_simulator.getSuccessors(a);
+            LabeledGraph::TransitionIterator it;
+            for (it = successors.first; it != successors.second; ++it) {
+                if (it->label != m_tau) {
+                    hasLabel[it->label].set(a);
+                } else {
+                    assert(it->state < a);
+                    for (size_t l = 0; l < labelCount; ++l) {
+                        if (hasLabel[l].test(it->state))
+                            hasLabel[l].set(a);
+                    }
+                }
+            }
+        }
+        
+        m_targets.resize(labelCount);
+        for (size_t b = 0; b < simulateeCount; ++b) {
+            const LabeledGraph::TransitionRange predecessors = m_simulatee.getPredecessors(b);
+            LabeledGraph::TransitionIterator it;
+            for (it = predecessors.first; it != predecessors.second; ++it) {
+                if (it->label != m_tau && (it == predecessors.first || it->label != (it - 1)->label))
+                    m_targets[it->label].push_back(b);
+            }
+        }
+        
+        for (size_t b = 0; b < simulateeCount; ++b) {
+            BitSet& simulators = m_relation[b];
+            simulators.fill();
+            
+            const LabeledGraph::TransitionRange successors = m_simulatee.getSuccessors(b);
+            LabeledGraph::TransitionIterator it;
+            for (it = successors.first; it != successors.second; ++it) {
+                if (it->label != m_tau && (it == successors.first || it->label != (it - 1)->label))
+                    simulators &= hasLabel[it->label];
+            }
+        }
+        
+        // Count the successors of the candidate simulators that simulate each target. The
+        // relation must not change before all counters are known.
+        m_targetOffsets.resize(labelCount + 1, 0);
+        for (size_t l = 0; l < labelCount; ++l)
+            m_targetOffsets[l + 1] = m_targetOffsets[l] + m_targets[l].size();
+        m_counterOffsets.reserve(m_targetOffsets.back() + 1);
+        m_counterOffsets.push_back(0);
+        
+        BitSet candidates(simulatorCount);
+        for (size_t l = 0; l < labelCount; ++l) {
+            for (size_t j = 0; j < m_targets[l].size(); ++j)
+                initializeCounters(l, j, hasLabel, candidates);
+        }
+        
+        for (size_t l = 0; l < labelCount; ++l) {
+            const IndexList& targets = m_targets[l];
+            for (size_t j = 0; j < targets.size(); ++j) {
+                const size_t slot = m_targetOffsets[l] + j;
+                for (size_t i = m_counterOffsets[slot]; i < m_counterOffsets[slot + 1]; ++i) {
+                    if (m_counters[i] == 0)
+                        removeFromPredecessors(m_counterStates[i], l, targets[j], removed);
+                }
+            }
+        }
+        
+        // for weak simulation, a tau transition b -tau-> b' requires that the simulators of b
+        // also simulate b'
+        if (m_tau != None) {
+            for (size_t b = 0; b < simulateeCount; ++b) {
+                BitSet& simulators = m_relation[b];
+                const LabeledGraph::TransitionRange successors = m_simulatee.getSuccessors(b, m_tau);
+                LabeledGraph::TransitionIterator it;
+                for (it = successors.first; it != successors.second; ++it) {
+                    const BitSet& successorSimulators = m_relation[it->state];
+                    for (size_t a = simulators.findFirst(); a < simulatorCount; a = simulators.findNext(a + 1)) {
+                        if (!successorSimulators.test(a)) {
+                            simulators.reset(a);
+                            removed.push_back(std::make_pair(b, a));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    void Simulation::initializeCounters(const size_t label, const size_t target, const std::vector<BitSet>& hasLabel, BitSet& candidates) {
+        // the candidates are the simulators of the l-predecessors of b', and for weak simulation
+        // their tau successor components with an l-transition, whose counters they depend on
+        const size_t simulatorCount = m_simulator.getStateCount();
+        const size_t simulateeState = m_targets[label][target];
+        const LabeledGraph::TransitionRange predecessors = m_simulatee.getPredecessors(simulateeState, label);
+        LabeledGraph::TransitionIterator it;
+        for (it = predecessors.first; it != predecessors.second; ++it)
+            candidates |= m_relation[it->state];
+        
+        const size_t first = m_counterStates.size();
+        for (size_t a = candidates.findFirst(); a < simulatorCount; a = candidates.findNext(a + 1))
+            m_counterStates.push_back(a);
+        
+        if (m_tau != None) {
+            for (size_t i = first; i < m_counterStates.size(); ++i) {
+                const LabeledGraph::TransitionRange tauSuccessors = m_simulator.getSuccessors(m_counterStates[i], m_tau);
+                for (it = tauSuccessors.first; it != tauSuccessors.second; ++it) {
+                    if (hasLabel[label].test(it->state) && candidates.testAndSet(it->state))
+                        m_counterStates.push_back(it->state);
+                }
+            }
+            std::sort(m_counterStates.begin() + first, m_counterStates.end());
+        }
+        
+        // the tau successor components of a have smaller indices, so their counters are known
+        const BitSet& successorSimulators = m_relation[simulateeState];
+        m_counters.resize(m_counterStates.size(), 0);
+        m_counterOffsets.push_back(m_counterStates.size());
+        for (size_t i = first; i < m_counterStates.size(); ++i) {
+            const size_t a = m_counterStates[i];
+            candidates.reset(a);
+            
+            uint32_t counter = 0;
+            const LabeledGraph::TransitionRange successors = m_simulator.getSuccessors(a, label);
+            for (it = successors.first; it != successors.second; ++it) {
+                if (successorSimulators.test(it->state))
+                    ++counter;
+            }
+            if (m_tau != None) {
+                const LabeledGraph::TransitionRange tauSuccessors = m_simulator.getSuccessors(a, m_tau);
+                for (it = tauSuccessors.first; it != tauSuccessors.second; ++it) {
+                    const size_t index = getCounter(label, it->state, target);
+                    if (index != None && m_counters[index] > 0)
+                        ++counter;
+                }
+            }
+            m_counters[i] = counter;
+        }
+    }
+    
+    void Simulation::refine(PairList& removed) {
+        LossList losses;
+        while (!removed.empty() || !losses.empty()) {
+            if (!losses.empty()) {
+                const Loss loss = losses.back();
+                losses.pop_back();
+                removeFromPredecessors(loss.simulatorState, loss.label, loss.simulateeState, removed);
+                
+                // the tau predecessors of a lose one way to reach an l-successor that simulates b'
+                if (m_tau != None) {
+                    const size_t target = getRank(m_targets[loss.label], loss.simulateeState);
+                    const LabeledGraph::TransitionRange predecessors = m_simulator.getPredecessors(loss.simulatorState, m_tau);
+                    LabeledGraph::TransitionIterator it;
+                    for (it = predecessors.first; it != predecessors.second; ++it) {
+                        const size_t index = getCounter(loss.label, it->state, target);
+                        if (index == None)
+                            continue; // the predecessor cannot simulate any l-predecessor of b'
+                        
+                        uint32_t& counter = m_counters[index];
+                        assert(counter > 0);
+                        if (--counter == 0)
+                            losses.push_back(Loss(loss.label, it->state, loss.simulateeState));
+                    }
+                }
+                continue;
+            }
+            
+            const Pair pair = removed.back();
+            removed.pop_back();
+            
+            // a' no longer simulates b', so a -l-> a' no longer helps a to simulate b -l-> b'
+            const size_t bSucc = pair.first;
+            const size_t aSucc = pair.second;
+            
+            const LabeledGraph::TransitionRange aPredecessors = m_simulator.getPredecessors(aSucc);
+            LabeledGraph::TransitionIterator aIt;
+            size_t target = 0;
+            for (aIt = aPredecessors.first; aIt != aPredecessors.second; ++aIt) {
+                const size_t label = aIt->label;
+                const size_t a = aIt->state;
+                if (label == m_tau)
+                    continue;
+                
+                if (aIt == aPredecessors.first || label != (aIt - 1)->label)
+                    target = getRank(m_targets[label], bSucc);
+                if (target == m_targets[label].size())
+                    continue; // b' has no l-predecessors
+                
+                const size_t index = getCounter(label, a, target);
+                if (index == None)
+                    continue; // a cannot simulate any l-predecessor of b'
+                
+                uint32_t& counter = m_counters[index];
+                assert(counter > 0);
+                if (--counter == 0)
+                    losses.push_back(Loss(label, a, bSucc));
+            }
+            
+            // a' no longer simulates b', so it cannot simulate any b with b -tau-> b'
+            if (m_tau != None) {
+                const LabeledGraph::TransitionRange bPredecessors = m_simulatee.getPredecessors(bSucc, m_tau);
+                LabeledGraph::TransitionIterator bIt;
+                for (bIt = bPredecessors.first; bIt != bPredecessors.second; ++bIt) {
+                    const size_t b = bIt->state;
+                    BitSet& simulators = m_relation[b];
+                    if (simulators.test(aSucc)) {
+                        simulators.reset(aSucc);
+                        removed.push_back(std::make_pair(b, aSucc));
+                    }
+                }
+            }
+        }
+    }
+    
+    void Simulation::removeFromPredecessors(const size_t simulatorState, const size_t label, const size_t simulateeState, PairList& removed) {
+        // a has no l-successor left that simulates b', so a cannot simulate any b with b -l-> b'
+        const LabeledGraph::TransitionRange bPredecessors = m_simulatee.getPredecessors(simulateeState, label);
+        LabeledGraph::TransitionIterator it;
+        for (it = bPredecessors.first; it != bPredecessors.second; ++it) {
+            const size_t b = it->state;
+            BitSet& simulators = m_relation[b];
+            if (simulators.test(simulatorState)) {
+                simulators.reset(simulatorState);
+                removed.push_back(std::make_pair(b, simulatorState));
+            }
+        }
+    }
+    
+    size_t Simulation::getCounter(const size_t label, const size_t source, const size_t target) const {
+        const size_t slot = m_targetOffsets[label] + target;
+        assert(slot + 1 < m_counterOffsets.size());
+        const IndexList::const_iterator first = m_counterStates.begin() + m_counterOffsets[slot];
+        const IndexList::const_iterator last = m_counterStates.begin() + m_counterOffsets[slot + 1];
+        const IndexList::const_iterator it = std::lower_bound(first, last, source);
+        if (it == last || *it != source)
+            return None;
+        return static_cast<size_t>(it - m_counterStates.begin());
+    }
+    
+    size_t Simulation::getRank(const IndexList& states, const size_t state) {
+        const IndexList::const_iterator it = std::lower_bound(states.begin(), states.end(), state);
+        if (it == states.end() || *it != state)
+            return states.size();
+        return static_cast<size_t>(it - states.begin());
+    }
+}
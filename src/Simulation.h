@@ -0,0 +1,314 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__Simulation__
+#define __Tippi__Simulation__
+
+#include "BitSet.h"
+#include "Label.h"
+#include "StringUtils.h"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace Tippi {
+    /**
+     Maps edge labels to consecutive indices so that two automata can be compared by label index.
+     Interned labels are mapped through a table indexed by their global label index, so that only
+     the first lookup of each label needs to compare strings.
+     
+     A label can also be qualified by a type, e.g. the type of a closure edge, and every pair of
+     label and type is mapped to an index of its own. These indices are looked up by the global
+     label index without comparing strings at all.
+     */
+    class LabelIndex {
+    public:
+        typedef std::pair<Label, size_t> TypedLabel;
+    private:
+        static const size_t None = static_cast<size_t>(-1);
+        
+        typedef std::map<String, size_t> Map;
+        Map m_indices;
+        StringList m_labels;
+        std::vector<size_t> m_labelIndices;
+        std::vector<std::vector<size_t> > m_typedLabelIndices;
+    public:
+        size_t getIndex(const String& label);
+        size_t getIndex(const Label& label);
+        size_t getIndex(const TypedLabel& label);
+        const String& getLabel(size_t index) const;
+        size_t size() const;
+    };
+    
+    /**
+     A compact, immutable representation of the transition relation of an automaton. The states
+     are identified by their indices and the outgoing and incoming transitions of each state are
+     stored in contiguous arrays which are sorted by label index.
+     */
+    class LabeledGraph {
+    public:
+        struct Transition {
+            size_t label;
+            size_t state;
+            
+            Transition(size_t i_label, size_t i_state);
+            bool operator<(const Transition& rhs) const;
+            bool operator==(const Transition& rhs) const;
+        };
+        
+        typedef std::vector<Transition> TransitionList;
+        typedef TransitionList::const_iterator TransitionIterator;
+        typedef std::pair<TransitionIterator, TransitionIterator> TransitionRange;
+    private:
+        struct Edge {
+            size_t source;
+            size_t label;
+            size_t target;
+        };
+        
+        template <class E>
+        struct EdgeLabel {
+            const Label& operator()(const E* edge) const {
+                return edge->getLabel();
+            }
+        };
+        
+        size_t m_stateCount;
+        size_t m_labelCount;
+        std::vector<Edge> m_edges;
+        
+        std::vector<size_t> m_successorOffsets;
+        TransitionList m_successors;
+        std::vector<size_t> m_predecessorOffsets;
+        TransitionList m_predecessors;
+    public:
+        LabeledGraph(size_t stateCount);
+        
+        /**
+         Builds the graph of the given automaton. The states are identified by their ids.
+         */
+        template <class A>
+        static LabeledGraph build(const A& automaton, LabelIndex& labels) {
+            return build(automaton, labels, EdgeLabel<typename A::Edge>());
+        }
+        
+        /**
+         Builds the graph of the given automaton. The label of each edge is determined by the
+         given function.
+         */
+        template <class A, class L>
+        static LabeledGraph build(const A& automaton, LabelIndex& labels, const L& edgeLabel) {
+            LabeledGraph graph(automaton.getMaxId() + 1);
+            
+            const typename A::EdgeSet& edges = automaton.getEdges();
+            typename A::EdgeSet::const_iterator it, end;
+            for (it = edges.begin(), end = edges.end(); it != end; ++it) {
+                const typename A::Edge* edge = *it;
+                graph.addEdge(edge->getSource()->getId(), labels.getIndex(edgeLabel(edge)), edge->getTarget()->getId());
+            }
+            
+            graph.freeze();
+            return graph;
+        }
+        
+        /**
+         Adds an edge. All edges must be added before the graph is frozen.
+         */
+        void addEdge(size_t source, size_t label, size_t target);
+        
+        /**
+         Builds the transition arrays from the added edges.
+         */
+        void freeze();
+        
+        size_t getStateCount() const;
+        size_t getLabelCount() const;
+        TransitionRange getSuccessors(size_t state) const;
+        TransitionRange getSuccessors(size_t state, size_t label) const;
+        TransitionRange getPredecessors(size_t state) const;
+        TransitionRange getPredecessors(size_t state, size_t label) const;
+    private:
+        static void buildTransitions(size_t stateCount, const std::vector<Edge>& edges, bool forward, std::vector<size_t>& offsets, TransitionList& transitions);
+        static TransitionRange getRange(const std::vector<size_t>& offsets, const TransitionList& transitions, size_t state);
+        static TransitionRange getRange(const std::vector<size_t>& offsets, const TransitionList& transitions, size_t state, size_t label);
+    };
+    
+    /**
+     Groups the states of a labeled graph into the strongly connected components of the subgraph
+     of tau transitions. The components are numbered in reverse topological order, so every
+     component that is reachable from a component by tau transitions has a smaller index.
+     */
+    class TauComponents {
+    public:
+        typedef std::vector<size_t> IndexList;
+        typedef IndexList::const_iterator IndexIterator;
+        typedef std::pair<IndexIterator, IndexIterator> IndexRange;
+    private:
+        IndexList m_componentOf;
+        IndexList m_memberOffsets;
+        IndexList m_members;
+    public:
+        TauComponents(const LabeledGraph& graph, size_t tau);
+        
+        size_t getComponentCount() const;
+        size_t getComponent(size_t state) const;
+        
+        /**
+         Returns the states of the given component.
+         */
+        IndexRange getMembers(size_t component) const;
+        
+        /**
+         Builds the graph of the components. It contains a transition C -l-> D for every
+         transition c -l-> d with c in C and d in D unless l is tau and C and D are the same
+         component. Thus the tau transitions of the component graph form a directed acyclic graph.
+         */
+        LabeledGraph buildComponentGraph(const LabeledGraph& graph, size_t tau) const;
+    protected:
+        static IndexRange getRange(const IndexList& offsets, const IndexList& values, size_t index);
+    private:
+        void addComponent(IndexList& stack, size_t root);
+    };
+    
+    /**
+     Computes the tau closures of the states of a labeled graph. All states of a tau component
+     have the same closure, so the closures are stored once per component as the sorted list of
+     reachable components.
+     */
+    class TauClosure : public TauComponents {
+    private:
+        IndexList m_closureOffsets;
+        IndexList m_closures;
+    public:
+        TauClosure(const LabeledGraph& graph, size_t tau);
+        
+        /**
+         Returns the components that are reachable from the given component by tau transitions,
+         including the component itself.
+         */
+        IndexRange getClosure(size_t component) const;
+    };
+    
+    /**
+     Computes the greatest simulation relation between the states of two labeled graphs. A state a
+     of the simulator simulates a state b of the simulatee if for every transition b -l-> b', there
+     is a transition a -l-> a' such that a' simulates b'.
+     
+     The relation is stored as one bit set of simulator states per simulatee state. It is
+     initialized with all simulator states that have at least the labels of the simulatee state and
+     then refined until it is stable, following Henzinger, Henzinger and Kopke. For every label l
+     and every simulatee state b' with an l-predecessor, a counter stores for a simulator state a
+     the number of l-successors of a that still simulate b'. When a simulator state a' is removed
+     from the set of b', the counters of the l-predecessors a of a' are decremented, and once the
+     counter of a reaches zero, a is removed from the sets of all l-predecessors b of b'. Thus
+     every transition pair is examined a constant number of times. A counter is only stored for
+     the states a which initially simulate some l-predecessor of b', since the counters of all
+     other states are never needed.
+     
+     Weak simulation is computed without saturating the simulator. If a state a' is reachable from
+     a by tau transitions, then a weakly simulates every state that a' weakly simulates. Hence an
+     observable transition b -l-> b' only needs to be matched by a tau path from a followed by a
+     single l-transition to a simulator of b', and a tau transition b -tau-> b' only needs a to
+     simulate b' itself. Since all states of a tau component simulate the same states, the
+     relation is computed for the components of the simulator, and the counter of a component C
+     also counts the tau successor components of C whose counter is not zero. Because the tau
+     transitions between components are acyclic, these counters are exact. The counters are also
+     stored for the tau successor components of the states that initially simulate an
+     l-predecessor of b'.
+     */
+    class Simulation {
+    private:
+        static const size_t None = static_cast<size_t>(-1);
+        
+        typedef std::pair<size_t, size_t> Pair;
+        typedef std::vector<Pair> PairList;
+        typedef std::vector<size_t> IndexList;
+        typedef std::vector<uint32_t> CounterList;
+        
+        struct Loss {
+            size_t label;
+            size_t simulatorState;
+            size_t simulateeState;
+            
+            Loss(size_t i_label, size_t i_simulatorState, size_t i_simulateeState);
+        };
+        typedef std::vector<Loss> LossList;
+        
+        /**
+         For weak simulation, the index of the unobservable label, the tau component of each
+         simulator state and the component graph of the simulator, otherwise None and empty.
+         */
+        size_t m_tau;
+        IndexList m_componentOf;
+        LabeledGraph m_componentGraph;
+        
+        const LabeledGraph& m_simulator;
+        const LabeledGraph& m_simulatee;
+        std::vector<BitSet> m_relation;
+        
+        /**
+         For each label l, the simulatee states with an l-predecessor, sorted. The counters of the
+         j-th of these states are stored in the range of m_counters starting at
+         m_counterOffsets[m_targetOffsets[l] + j], sorted by the simulator states in the parallel
+         array m_counterStates.
+         */
+        std::vector<IndexList> m_targets;
+        IndexList m_targetOffsets;
+        IndexList m_counterOffsets;
+        IndexList m_counterStates;
+        CounterList m_counters;
+    public:
+        /**
+         Computes the greatest simulation relation between the given graphs.
+         */
+        Simulation(const LabeledGraph& simulator, const LabeledGraph& simulatee);
+        
+        /**
+         Computes the greatest weak simulation relation between the given graphs.
+         
+         @param simulator the simulator
+         @param simulatee the simulatee
+         @param tau the index of the unobservable label
+         */
+        Simulation(const LabeledGraph& simulator, const LabeledGraph& simulatee, size_t tau);
+        
+        /**
+         Indicates whether the given simulator state simulates the given simulatee state.
+         */
+        bool simulates(size_t simulatorState, size_t simulateeState) const;
+    private:
+        static LabeledGraph buildComponentGraph(const LabeledGraph& simulator, size_t tau, IndexList& componentOf);
+        
+        void initialize(PairList& removed);
+        void initializeCounters(size_t label, size_t target, const std::vector<BitSet>& hasLabel, BitSet& candidates);
+        void refine(PairList& removed);
+        void removeFromPredecessors(size_t simulatorState, size_t label, size_t simulateeState, PairList& removed);
+        
+        /**
+         Returns the position of the counter of the given simulator state for the given label and
+         rank of the simulatee state in m_targets, or None if no counter is stored for it.
+         */
+        size_t getCounter(size_t label, size_t source, size_t target) const;
+        static size_t getRank(const IndexList& states, size_t state);
+    };
+}
+
+#endif /* defined(__Tippi__Simulation__) */
@@ -21,6 +21,7 @@
 #define Tippi_StringUtils_h
 
 #include <cassert>
+#include <cstdarg>
 #include <map>
 #include <set>
 #include <sstream>
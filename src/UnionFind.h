@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Tippi__UnionFind__
+#define __Tippi__UnionFind__
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace Tippi {
+    /**
+     A partition of the indices 0 to size() - 1 into disjoint sets. Initially, every index is in a
+     set of its own. Sets are merged by size and paths are halved during lookups, so that any
+     sequence of operations takes nearly linear time.
+     */
+    class UnionFind {
+    private:
+        std::vector<size_t> m_parents;
+        std::vector<size_t> m_sizes;
+    public:
+        /**
+         Creates a new partition of the given number of indices into singleton sets.
+         
+         @param size the number of indices
+         */
+        UnionFind(const size_t size = 0) :
+        m_parents(size),
+        m_sizes(size, 1) {
+            for (size_t i = 0; i < size; ++i)
+                m_parents[i] = i;
+        }
+        
+        size_t size() const {
+            return m_parents.size();
+        }
+        
+        /**
+         Adds a new index in a set of its own.
+         
+         @return the new index
+         */
+        size_t add() {
+            const size_t index = size();
+            m_parents.push_back(index);
+            m_sizes.push_back(1);
+            return index;
+        }
+        
+        /**
+         Returns the representative of the set that contains the given index. Two indices are in
+         the same set if and only if they have the same representative.
+         
+         @param index the index to look up
+         @return the representative of the set containing the index
+         */
+        size_t find(size_t index) {
+            assert(index < size());
+            while (m_parents[index] != index) {
+                m_parents[index] = m_parents[m_parents[index]];
+                index = m_parents[index];
+            }
+            return index;
+        }
+        
+        /**
+         Merges the sets that contain the given indices.
+         
+         @param first the first index
+         @param second the second index
+         @return true if the indices were in different sets and false otherwise
+         */
+        bool unite(const size_t first, const size_t second) {
+            size_t firstRoot = find(first);
+            size_t secondRoot = find(second);
+            if (firstRoot == secondRoot)
+                return false;
+            if (m_sizes[firstRoot] < m_sizes[secondRoot])
+                std::swap(firstRoot, secondRoot);
+            m_parents[secondRoot] = firstRoot;
+            m_sizes[firstRoot] += m_sizes[secondRoot];
+            return true;
+        }
+        
+        /**
+         Returns the number of indices in the set that contains the given index.
+         */
+        size_t setSize(const size_t index) {
+            return m_sizes[find(index)];
+        }
+    };
+}
+
+#endif /* defined(__Tippi__UnionFind__) */
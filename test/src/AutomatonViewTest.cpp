@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AutomatonView.h"
+#include "Behavior.h"
+#include "IntervalNetState.h"
+
+#include <vector>
+
+namespace Tippi {
+    typedef AutomatonView<Behavior> BehaviorView;
+    
+    struct HasId {
+        size_t id;
+        
+        HasId(const size_t i_id) :
+        id(i_id) {}
+        
+        bool operator()(const BehaviorState* state) const {
+            return state->getId() == id;
+        }
+    };
+    
+    /**
+     Creates the following behavior with initial state 1 and final state 4:
+     
+     1 -> 2 -> 3 -> 2, 1 -> 4, 5 -> 1
+     */
+    static std::vector<BehaviorState*> createBehavior(Behavior& behavior) {
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 5; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        behavior.setInitialState(states[0]);
+        states[3]->setFinal(true);
+        behavior.addFinalState(states[3]);
+        
+        behavior.connectWithObservableEdge(states[0], states[1], "a");
+        behavior.connectWithObservableEdge(states[1], states[2], "b");
+        behavior.connectWithObservableEdge(states[2], states[1], "c");
+        behavior.connectWithObservableEdge(states[0], states[3], "d");
+        behavior.connectWithObservableEdge(states[4], states[0], "e");
+        return states;
+    }
+    
+    TEST(AutomatonViewTest, showAllStates) {
+        Behavior behavior;
+        createBehavior(behavior);
+        
+        const BehaviorView view(behavior);
+        ASSERT_EQ(5u, view.getStates().size());
+        ASSERT_TRUE(view.getHiddenStates().empty());
+        ASSERT_EQ(5u, view.getSortedEdges().size());
+        ASSERT_EQ(behavior.getInitialState(), view.getInitialState());
+        ASSERT_EQ(1u, view.getFinalStates().size());
+    }
+    
+    TEST(AutomatonViewTest, hideStates) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createBehavior(behavior);
+        
+        BehaviorView view(behavior);
+        view.hideIf(HasId(states[2]->getId())).hideUnreachable();
+        
+        // state 3 is hidden explicitly and state 5 is unreachable
+        const BehaviorView::StateList visible = view.getStates();
+        ASSERT_EQ(3u, visible.size());
+        ASSERT_FALSE(view.isVisible(states[2]));
+        ASSERT_FALSE(view.isVisible(states[4]));
+        ASSERT_EQ(2u, view.getHiddenStates().size());
+        ASSERT_EQ(2u, view.getSortedEdges().size());
+        ASSERT_EQ(states[0], view.getInitialState());
+        
+        // the automaton itself is unchanged
+        ASSERT_EQ(5u, behavior.getStates().size());
+        ASSERT_EQ(5u, behavior.getEdges().size());
+        ASSERT_EQ(2u, states[1]->getIncoming().size());
+    }
+    
+    TEST(AutomatonViewTest, hideInitialState) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createBehavior(behavior);
+        
+        BehaviorView view(behavior);
+        view.hide(states[0]);
+        ASSERT_TRUE(view.getInitialState() == NULL);
+        ASSERT_EQ(2u, view.getSortedEdges().size());
+        
+        view.hideUnreachable();
+        ASSERT_TRUE(view.getStates().empty());
+        ASSERT_TRUE(view.getFinalStates().empty());
+    }
+    
+    TEST(AutomatonViewTest, restrictToComponent) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createBehavior(behavior);
+        
+        const BehaviorView view(behavior);
+        const Behavior::Components components = view.computeComponents();
+        const size_t component = components.getComponent(states[1]);
+        
+        BehaviorView componentView(behavior);
+        componentView.restrictTo(components, component);
+        ASSERT_EQ(2u, componentView.getStates().size());
+        ASSERT_EQ(2u, componentView.getSortedEdges().size());
+        
+        // hiding a state splits the component
+        BehaviorView pruned(behavior);
+        pruned.hide(states[2]);
+        const Behavior::Components prunedComponents = pruned.computeComponents();
+        ASSERT_EQ(Behavior::Components::None, prunedComponents.getComponent(states[2]));
+        
+        BehaviorView prunedComponentView(behavior);
+        prunedComponentView.restrictTo(prunedComponents, prunedComponents.getComponent(states[1]));
+        ASSERT_EQ(1u, prunedComponentView.getStates().size());
+    }
+}
@@ -70,6 +70,138 @@ namespace Tippi {
         ASSERT_NE(edge, behavior.connectWithObservableEdge(state1, state2, "test2"));
     }
     
+    TEST(BehaviorTest, sortedEdges) {
+        Behavior behavior;
+        
+        // the states are created in reverse order of their keys
+        BehaviorState* state2 = behavior.createState(Interval::NetState(Marking::createMarking(2), Marking::createMarking(0)));
+        BehaviorState* state1 = behavior.createState(Interval::NetState(Marking::createMarking(1), Marking::createMarking(0)));
+        BehaviorState* state0 = behavior.createState(Interval::NetState(Marking::createMarking(0), Marking::createMarking(0)));
+        
+        const BehaviorEdge* edge21 = behavior.connectWithObservableEdge(state2, state1, "a");
+        const BehaviorEdge* edge10b = behavior.connectWithObservableEdge(state1, state0, "b");
+        const BehaviorEdge* edge10a = behavior.connectWithObservableEdge(state1, state0, "a");
+        const BehaviorEdge* edge02 = behavior.connectWithObservableEdge(state0, state2, "a");
+        ASSERT_EQ(edge10a, behavior.connectWithObservableEdge(state1, state0, "a"));
+        ASSERT_EQ(4u, behavior.getEdges().size());
+        
+        const Behavior::EdgeList edges = behavior.getSortedEdges();
+        ASSERT_EQ(4u, edges.size());
+        ASSERT_EQ(edge02, edges[0]);
+        ASSERT_EQ(edge10a, edges[1]);
+        ASSERT_EQ(edge10b, edges[2]);
+        ASSERT_EQ(edge21, edges[3]);
+    }
+    
+    TEST(BehaviorTest, deleteStates) {
+        Behavior behavior;
+        
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 5; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        behavior.setInitialState(states[0]);
+        states[4]->setFinal(true);
+        behavior.addFinalState(states[4]);
+        
+        // 0 -> 1 -> 2 -> 3 -> 4, 0 -> 2, 2 -> 2, 4 -> 0
+        behavior.connectWithObservableEdge(states[0], states[1], "a");
+        behavior.connectWithObservableEdge(states[1], states[2], "b");
+        behavior.connectWithObservableEdge(states[2], states[3], "c");
+        behavior.connectWithObservableEdge(states[3], states[4], "d");
+        behavior.connectWithObservableEdge(states[0], states[2], "e");
+        behavior.connectWithObservableEdge(states[2], states[2], "f");
+        behavior.connectWithObservableEdge(states[4], states[0], "g");
+        
+        std::vector<BehaviorState*> deleted;
+        deleted.push_back(states[1]);
+        deleted.push_back(states[4]);
+        deleted.push_back(states[1]);
+        behavior.deleteStates(deleted.begin(), deleted.end());
+        
+        ASSERT_EQ(3u, behavior.getStates().size());
+        ASSERT_EQ(3u, behavior.getEdges().size());
+        ASSERT_TRUE(behavior.getFinalStates().empty());
+        ASSERT_EQ(states[0], behavior.getInitialState());
+        
+        ASSERT_EQ(1u, states[0]->getOutgoing().size());
+        ASSERT_TRUE(states[0]->getIncoming().empty());
+        ASSERT_EQ(states[2], states[0]->findDirectSuccessor("e"));
+        ASSERT_EQ(2u, states[2]->getIncoming().size());
+        ASSERT_EQ(2u, states[2]->getOutgoing().size());
+        ASSERT_TRUE(states[3]->getOutgoing().empty());
+        
+        deleted.clear();
+        deleted.push_back(states[0]);
+        behavior.deleteStates(deleted.begin(), deleted.end());
+        ASSERT_TRUE(behavior.getInitialState() == NULL);
+        ASSERT_EQ(1u, states[2]->getIncoming().size());
+    }
+    
+    TEST(BehaviorTest, mergeStates) {
+        Behavior behavior;
+        
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 5; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        
+        // 0, 1 and 2 are connected to both 3 and 4, and 0 -> 4 duplicates 0 -> 3
+        behavior.connectWithObservableEdge(states[0], states[3], "a");
+        behavior.connectWithObservableEdge(states[1], states[3], "b");
+        behavior.connectWithObservableEdge(states[2], states[3], "c");
+        behavior.connectWithObservableEdge(states[2], states[4], "d");
+        behavior.connectWithObservableEdge(states[0], states[4], "a");
+        behavior.connectWithObservableEdge(states[1], states[4], "e");
+        behavior.connectWithObservableEdge(states[4], states[4], "f");
+        
+        behavior.mergeStates(states[3], states[4]);
+        ASSERT_EQ(4u, behavior.getStates().size());
+        ASSERT_EQ(6u, behavior.getEdges().size());
+        ASSERT_EQ(1u, states[0]->getOutgoing().size());
+        ASSERT_EQ(2u, states[1]->getOutgoing().size());
+        ASSERT_EQ(2u, states[2]->getOutgoing().size());
+        ASSERT_EQ(6u, states[3]->getIncoming().size());
+        ASSERT_EQ(states[3], states[3]->findDirectSuccessor("f"));
+        
+        // removing an edge from the middle of the incoming edges keeps the others reachable
+        std::vector<BehaviorState*> deleted;
+        deleted.push_back(states[1]);
+        behavior.deleteStates(deleted.begin(), deleted.end());
+        ASSERT_EQ(4u, states[3]->getIncoming().size());
+        ASSERT_EQ(states[3], states[0]->findDirectSuccessor("a"));
+        ASSERT_EQ(states[3], states[2]->findDirectSuccessor("c"));
+        ASSERT_EQ(states[3], states[2]->findDirectSuccessor("d"));
+        ASSERT_EQ(states[2], states[3]->findDirectPredecessor("d"));
+    }
+    
+    TEST(BehaviorTest, labelIndex) {
+        Behavior behavior;
+        
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 4; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        behavior.setInitialState(states[0]);
+        
+        behavior.connectWithObservableEdge(states[0], states[1], "b");
+        behavior.connectWithObservableEdge(states[0], states[2], "a");
+        behavior.connectWithObservableEdge(states[0], states[3], "b");
+        behavior.connectWithObservableEdge(states[2], states[1], "c");
+        
+        ASSERT_EQ(states[2], states[0]->findDirectSuccessor("a"));
+        ASSERT_EQ(2u, states[0]->getDirectSuccessors("b").size());
+        ASSERT_FALSE(states[0]->hasOutgoingEdge("d"));
+        ASSERT_EQ(1u, states[1]->getDirectPredecessors("b").size());
+        ASSERT_EQ(states[2], states[1]->findDirectPredecessor("c"));
+        
+        // adding or removing an edge discards the index of its source and target
+        behavior.connectWithObservableEdge(states[0], states[3], "d");
+        ASSERT_EQ(states[3], states[0]->findDirectSuccessor("d"));
+        ASSERT_EQ(states[0], states[3]->findDirectPredecessor("d"));
+        
+        behavior.deleteState(states[3]);
+        ASSERT_EQ(1u, states[0]->getDirectSuccessors("b").size());
+        ASSERT_FALSE(states[0]->hasOutgoingEdge("d"));
+    }
+    
     TEST(BehaviorTest, checkDeterministicSimulation) {
         Behavior beh1;
         Behavior beh2;
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Bisimulation.h"
+#include "Simulation.h"
+
+namespace Tippi {
+    TEST(BisimulationTest, initialClasses) {
+        // 0 -a-> 1, 2 -a-> 3, where 1 and 3 are in different initial classes
+        LabeledGraph graph(4);
+        graph.addEdge(0, 0, 1);
+        graph.addEdge(2, 0, 3);
+        graph.freeze();
+        
+        std::vector<size_t> classes(4, 0);
+        const Bisimulation sameClasses(graph, classes);
+        ASSERT_EQ(2u, sameClasses.getBlockCount());
+        ASSERT_EQ(sameClasses.getBlock(0), sameClasses.getBlock(2));
+        ASSERT_EQ(sameClasses.getBlock(1), sameClasses.getBlock(3));
+        
+        classes[3] = 1;
+        const Bisimulation differentClasses(graph, classes);
+        ASSERT_EQ(4u, differentClasses.getBlockCount());
+        ASSERT_NE(differentClasses.getBlock(0), differentClasses.getBlock(2));
+    }
+    
+    TEST(BisimulationTest, labels) {
+        // 0 -a-> 1, 2 -b-> 3
+        LabeledGraph graph(4);
+        graph.addEdge(0, 0, 1);
+        graph.addEdge(2, 1, 3);
+        graph.freeze();
+        
+        const Bisimulation bisimulation(graph, std::vector<size_t>(4, 0));
+        ASSERT_EQ(3u, bisimulation.getBlockCount());
+        ASSERT_NE(bisimulation.getBlock(0), bisimulation.getBlock(2));
+        ASSERT_EQ(bisimulation.getBlock(1), bisimulation.getBlock(3));
+    }
+    
+    TEST(BisimulationTest, cycles) {
+        // 0 -a-> 1 -a-> 0 and 2 -a-> 2 are bisimilar, 3 -a-> 4 is not
+        LabeledGraph graph(5);
+        graph.addEdge(0, 0, 1);
+        graph.addEdge(1, 0, 0);
+        graph.addEdge(2, 0, 2);
+        graph.addEdge(3, 0, 4);
+        graph.freeze();
+        
+        const Bisimulation bisimulation(graph, std::vector<size_t>(5, 0));
+        ASSERT_EQ(3u, bisimulation.getBlockCount());
+        ASSERT_EQ(bisimulation.getBlock(0), bisimulation.getBlock(1));
+        ASSERT_EQ(bisimulation.getBlock(0), bisimulation.getBlock(2));
+        ASSERT_NE(bisimulation.getBlock(3), bisimulation.getBlock(0));
+        ASSERT_NE(bisimulation.getBlock(3), bisimulation.getBlock(4));
+    }
+    
+    TEST(BisimulationTest, nondeterminism) {
+        // 0 -a-> 4, 1 -a-> 4, 1 -a-> 5, 2 -a-> 5, 3 -a-> 5, 4 -b-> 6
+        // 0 and 1 must not be merged even though both have an a-transition to 4
+        LabeledGraph graph(7);
+        graph.addEdge(0, 0, 4);
+        graph.addEdge(1, 0, 4);
+        graph.addEdge(1, 0, 5);
+        graph.addEdge(2, 0, 5);
+        graph.addEdge(3, 0, 5);
+        graph.addEdge(4, 1, 6);
+        graph.freeze();
+        
+        const Bisimulation bisimulation(graph, std::vector<size_t>(7, 0));
+        ASSERT_EQ(5u, bisimulation.getBlockCount());
+        ASSERT_NE(bisimulation.getBlock(0), bisimulation.getBlock(1));
+        ASSERT_NE(bisimulation.getBlock(1), bisimulation.getBlock(2));
+        ASSERT_EQ(bisimulation.getBlock(2), bisimulation.getBlock(3));
+        ASSERT_EQ(bisimulation.getBlock(5), bisimulation.getBlock(6));
+        ASSERT_NE(bisimulation.getBlock(4), bisimulation.getBlock(5));
+    }
+}
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <map>
+#include <string>
 #include <vector>
 
 class TestObject {
@@ -429,3 +430,111 @@ TEST(CollectionUtilsTest, mapClearAndDelete) {
     ASSERT_TRUE(deleted1);
     ASSERT_TRUE(deleted2);
 }
+
+TEST(CollectionUtilsTest, smallVectorGrowsBeyondInlineStorage) {
+    Utils::SmallVector<std::string, 2> vector;
+    vector.push_back("a");
+    vector.push_back("b");
+    ASSERT_TRUE(vector.isInline());
+    
+    vector.push_back("c");
+    ASSERT_FALSE(vector.isInline());
+    ASSERT_EQ(3u, vector.size());
+    ASSERT_EQ(std::string("a"), vector[0]);
+    ASSERT_EQ(std::string("b"), vector[1]);
+    ASSERT_EQ(std::string("c"), vector[2]);
+    
+    Utils::SmallVector<std::string, 2> copy(vector);
+    Utils::SmallVector<std::string, 2> moved(std::move(vector));
+    ASSERT_TRUE(vector.empty());
+    ASSERT_EQ(3u, copy.size());
+    ASSERT_EQ(3u, moved.size());
+    ASSERT_EQ(std::string("c"), moved.back());
+}
+
+TEST(CollectionUtilsTest, smallVectorInsertAndErase) {
+    Utils::SmallVector<int, 4> vector;
+    vector.push_back(1);
+    vector.push_back(3);
+    vector.insert(vector.begin() + 1, 2);
+    vector.insert(vector.begin(), 0);
+    vector.insert(vector.end(), 4);
+    
+    ASSERT_EQ(5u, vector.size());
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(i, vector[static_cast<size_t>(i)]);
+    
+    vector.erase(vector.begin() + 1, vector.begin() + 3);
+    ASSERT_EQ(3u, vector.size());
+    ASSERT_EQ(0, vector[0]);
+    ASSERT_EQ(3, vector[1]);
+    ASSERT_EQ(4, vector[2]);
+}
+
+TEST(CollectionUtilsTest, flatSetInsert) {
+    typedef Utils::FlatSet<int> TestSet;
+    
+    TestSet set;
+    ASSERT_TRUE(set.insert(3).second);
+    ASSERT_TRUE(set.insert(1).second);
+    ASSERT_TRUE(set.insert(2).second);
+    ASSERT_FALSE(set.insert(1).second);
+    ASSERT_EQ(3u, set.size());
+    
+    const int values[] = { 5, 2, 4, 0 };
+    set.insert(values, values + 4);
+    ASSERT_EQ(6u, set.size());
+    
+    int expected = 0;
+    TestSet::const_iterator it, end;
+    for (it = set.begin(), end = set.end(); it != end; ++it)
+        ASSERT_EQ(expected++, *it);
+}
+
+TEST(CollectionUtilsTest, flatSetFindAndErase) {
+    typedef Utils::FlatSet<int> TestSet;
+    
+    const int values[] = { 4, 8, 15, 16, 23, 42 };
+    TestSet set(values, values + 6);
+    ASSERT_EQ(1u, set.count(15));
+    ASSERT_EQ(0u, set.count(14));
+    ASSERT_EQ(set.end(), set.find(43));
+    ASSERT_EQ(23, *set.find(23));
+    
+    ASSERT_EQ(1u, set.erase(15));
+    ASSERT_EQ(0u, set.erase(15));
+    ASSERT_EQ(5u, set.size());
+    ASSERT_EQ(16, *set.lower_bound(15));
+}
+
+TEST(CollectionUtilsTest, flatSetCompare) {
+    typedef Utils::FlatSet<int> TestSet;
+    
+    const int values[] = { 1, 2, 3 };
+    const TestSet set1(values, values + 3);
+    const TestSet set2(values, values + 2);
+    ASSERT_TRUE(set1 == TestSet(values, values + 3));
+    ASSERT_TRUE(set1 != set2);
+    ASSERT_TRUE(set2 < set1);
+    ASSERT_FALSE(set1 < set2);
+}
+
+TEST(CollectionUtilsTest, flatMapInsertAndFind) {
+    typedef Utils::FlatMap<std::string, int> TestMap;
+    
+    TestMap map;
+    map["c"] = 3;
+    map["a"] = 1;
+    ASSERT_TRUE(map.insert(std::make_pair(std::string("b"), 2)).second);
+    ASSERT_FALSE(map.insert(std::make_pair(std::string("b"), 4)).second);
+    ASSERT_EQ(3u, map.size());
+    ASSERT_EQ(2, map["b"]);
+    
+    ASSERT_EQ(std::string("a"), map.begin()->first);
+    ASSERT_EQ(map.end(), map.find("d"));
+    ASSERT_EQ(3, map.find("c")->second);
+    
+    ASSERT_EQ(1u, map.erase("a"));
+    ASSERT_EQ(0u, map.count("a"));
+    ASSERT_EQ(2u, map.size());
+}
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "SimpleAutomaton.h"
+
+#include <cstdlib>
+
+namespace Tippi {
+    static SimpleAutomatonState* createState(SimpleAutomaton& automaton, const size_t index) {
+        StringStream name;
+        name << "s" << index;
+        return automaton.createState(name.str());
+    }
+    
+    TEST(ComponentsTest, computeComponents) {
+        // 0 -> 1 -> 2 -> 0, 2 -> 3 -> 4 -> 3, 5 is unreachable
+        SimpleAutomaton automaton;
+        std::vector<SimpleAutomatonState*> states;
+        for (size_t i = 0; i < 6; ++i)
+            states.push_back(createState(automaton, i));
+        automaton.setInitialState(states[0]);
+        automaton.connectWithObservableEdge(states[0], states[1], "a");
+        automaton.connectWithObservableEdge(states[1], states[2], "a");
+        automaton.connectWithObservableEdge(states[2], states[0], "a");
+        automaton.connectWithObservableEdge(states[2], states[3], "a");
+        automaton.connectWithObservableEdge(states[3], states[4], "a");
+        automaton.connectWithObservableEdge(states[4], states[3], "a");
+        automaton.connectWithObservableEdge(states[5], states[0], "a");
+        
+        const SimpleAutomaton::Components components = automaton.computeComponents();
+        ASSERT_EQ(2u, components.size());
+        
+        // the components are found in reverse topological order
+        ASSERT_EQ(2u, components.getStateCount(0));
+        ASSERT_TRUE(components.contains(0, states[3]));
+        ASSERT_TRUE(components.contains(0, states[4]));
+        
+        const SimpleAutomaton::Components::StateRange range = components.getStates(1);
+        ASSERT_EQ(3, std::distance(range.first, range.second));
+        ASSERT_EQ(states[0], range.first[0]);
+        ASSERT_EQ(states[1], range.first[1]);
+        ASSERT_EQ(states[2], range.first[2]);
+        
+        ASSERT_EQ(SimpleAutomaton::Components::None, components.getComponent(states[5]));
+    }
+    
+    TEST(ComponentsTest, longPath) {
+        // a path that is much longer than the call stack allows for a recursive implementation
+        const size_t length = 100000;
+        SimpleAutomaton automaton;
+        SimpleAutomatonState* previous = createState(automaton, 0);
+        automaton.setInitialState(previous);
+        for (size_t i = 1; i < length; ++i) {
+            SimpleAutomatonState* state = createState(automaton, i);
+            automaton.connectWithObservableEdge(previous, state, "a");
+            previous = state;
+        }
+        automaton.connectWithObservableEdge(previous, automaton.getInitialState(), "a");
+        
+        const SimpleAutomaton::Components components = automaton.computeComponents();
+        ASSERT_EQ(1u, components.size());
+        ASSERT_EQ(length, components.getStateCount(0));
+        
+        const SimpleAutomaton::Components parallelComponents = automaton.computeComponentsInParallel();
+        ASSERT_EQ(1u, parallelComponents.size());
+        ASSERT_EQ(length, parallelComponents.getStateCount(0));
+    }
+    
+    TEST(ComponentsTest, computeComponentsInParallel) {
+        const size_t stateCount = 200;
+        std::srand(1);
+        
+        for (size_t round = 0; round < 20; ++round) {
+            SimpleAutomaton automaton;
+            std::vector<SimpleAutomatonState*> states;
+            for (size_t i = 0; i < stateCount; ++i)
+                states.push_back(createState(automaton, i));
+            automaton.setInitialState(states[0]);
+            
+            for (size_t i = 0; i < 2 * stateCount; ++i) {
+                SimpleAutomatonState* source = states[static_cast<size_t>(std::rand()) % stateCount];
+                SimpleAutomatonState* target = states[static_cast<size_t>(std::rand()) % stateCount];
+                automaton.connectWithObservableEdge(source, target, "a");
+            }
+            
+            const SimpleAutomaton::Components expected = automaton.computeComponents();
+            const SimpleAutomaton::Components actual = automaton.computeComponentsInParallel();
+            ASSERT_EQ(expected.size(), actual.size());
+            
+            for (size_t i = 0; i < stateCount; ++i) {
+                for (size_t j = 0; j < stateCount; ++j) {
+                    const bool expectedSame = expected.getComponent(states[i]) == expected.getComponent(states[j]);
+                    const bool actualSame = actual.getComponent(states[i]) == actual.getComponent(states[j]);
+                    ASSERT_EQ(expectedSame, actualSame);
+                }
+            }
+        }
+    }
+}
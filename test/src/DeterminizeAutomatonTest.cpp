@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "DeterminizeAutomaton.h"
+#include "SimpleAutomaton.h"
+
+namespace Tippi {
+    TEST(DeterminizeAutomatonTest, emptyAutomaton) {
+        SimpleAutomaton automaton;
+        automaton.createState("i");
+        
+        DeterminizeAutomaton determinize;
+        const SimpleAutomaton::Ptr result = determinize(automaton);
+        ASSERT_TRUE(result->getStates().empty());
+        ASSERT_TRUE(result->getInitialState() == NULL);
+    }
+    
+    TEST(DeterminizeAutomatonTest, subsetConstruction) {
+        // i -a-> x -b-> y, i -a-> z -c-> y, y is final
+        SimpleAutomaton automaton;
+        SimpleAutomatonState* i = automaton.createState("i");
+        SimpleAutomatonState* x = automaton.createState("x");
+        SimpleAutomatonState* y = automaton.createState("y");
+        SimpleAutomatonState* z = automaton.createState("z");
+        automaton.setInitialState(i);
+        y->setFinal(true);
+        automaton.addFinalState(y);
+        automaton.connectWithObservableEdge(i, x, "a");
+        automaton.connectWithObservableEdge(i, z, "a");
+        automaton.connectWithObservableEdge(x, y, "b");
+        automaton.connectWithObservableEdge(z, y, "c");
+        
+        DeterminizeAutomaton determinize;
+        const SimpleAutomaton::Ptr result = determinize(automaton);
+        ASSERT_EQ(3u, result->getStates().size());
+        ASSERT_EQ(3u, result->getEdges().size());
+        
+        const SimpleAutomatonState* ri = result->getInitialState();
+        ASSERT_EQ(1u, ri->getOutgoing().size());
+        const SimpleAutomatonState* rxz = ri->findDirectSuccessor("a");
+        ASSERT_TRUE(rxz != NULL);
+        ASSERT_FALSE(rxz->isFinal());
+        
+        const SimpleAutomatonState* ry = rxz->findDirectSuccessor("b");
+        ASSERT_TRUE(ry != NULL);
+        ASSERT_TRUE(ry->isFinal());
+        ASSERT_EQ(ry, rxz->findDirectSuccessor("c"));
+        ASSERT_EQ(1u, result->getFinalStates().size());
+    }
+    
+    TEST(DeterminizeAutomatonTest, eliminateUnobservableEdges) {
+        // i -tau-> x -tau-> i, x -a-> y -tau-> f, i -b-> f, f is final
+        SimpleAutomaton automaton;
+        SimpleAutomatonState* i = automaton.createState("i");
+        SimpleAutomatonState* x = automaton.createState("x");
+        SimpleAutomatonState* y = automaton.createState("y");
+        SimpleAutomatonState* f = automaton.createState("f");
+        automaton.setInitialState(i);
+        f->setFinal(true);
+        automaton.addFinalState(f);
+        automaton.connectWithUnobservableEdge(i, x);
+        automaton.connectWithUnobservableEdge(x, i);
+        automaton.connectWithObservableEdge(x, y, "a");
+        automaton.connectWithUnobservableEdge(y, f);
+        automaton.connectWithObservableEdge(i, f, "b");
+        
+        DeterminizeAutomaton determinize;
+        SimpleAutomaton::Ptr result = determinize(automaton);
+        ASSERT_EQ(3u, result->getStates().size());
+        
+        const SimpleAutomatonState* ri = result->getInitialState();
+        ASSERT_FALSE(ri->isFinal());
+        ASSERT_EQ(2u, ri->getOutgoing().size());
+        ASSERT_TRUE(ri->findDirectSuccessor("a")->isFinal());
+        ASSERT_TRUE(ri->findDirectSuccessor("b")->isFinal());
+        ASSERT_TRUE(ri->findDirectSuccessor("") == NULL);
+        
+        // {y, f} and {f} have the same future
+        DeterminizeAutomaton minimize(true);
+        result = minimize(automaton);
+        ASSERT_EQ(2u, result->getStates().size());
+        ri = result->getInitialState();
+        ASSERT_EQ(ri->findDirectSuccessor("a"), ri->findDirectSuccessor("b"));
+    }
+    
+    TEST(DeterminizeAutomatonTest, traceInclusion) {
+        // the simulator has the traces a b and a c, but it must choose between b and c on a
+        SimpleAutomaton simulator;
+        SimpleAutomatonState* i = simulator.createState("i");
+        SimpleAutomatonState* x = simulator.createState("x");
+        SimpleAutomatonState* y = simulator.createState("y");
+        SimpleAutomatonState* z = simulator.createState("z");
+        simulator.setInitialState(i);
+        simulator.connectWithObservableEdge(i, x, "a");
+        simulator.connectWithObservableEdge(i, y, "a");
+        simulator.connectWithObservableEdge(x, z, "b");
+        simulator.connectWithObservableEdge(y, z, "c");
+        
+        SimpleAutomaton simulatee;
+        SimpleAutomatonState* j = simulatee.createState("j");
+        SimpleAutomatonState* k = simulatee.createState("k");
+        SimpleAutomatonState* l = simulatee.createState("l");
+        simulatee.setInitialState(j);
+        simulatee.connectWithObservableEdge(j, k, "a");
+        simulatee.connectWithObservableEdge(k, l, "b");
+        simulatee.connectWithObservableEdge(k, l, "c");
+        
+        ASSERT_FALSE(simulator.simulates(simulatee));
+        
+        DeterminizeAutomaton determinize(true);
+        ASSERT_TRUE(determinize(simulator)->simulates(*determinize(simulatee)));
+        ASSERT_TRUE(determinize(simulatee)->simulates(*determinize(simulator)));
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Behavior.h"
+#include "BitStateSearch.h"
+#include "ConstructBehavior.h"
+#include "IntervalNet.h"
+
+namespace Tippi {
+    static BitStateSearch::NetPtr createNet() {
+        using Interval::Net;
+        using Interval::Place;
+        using Interval::Transition;
+        using Interval::TimeInterval;
+        
+        BitStateSearch::NetPtr net(new Net());
+        
+        Place* A = net->createPlace("A");
+        Place* B = net->createPlace("B");
+        Place* C = net->createPlace("C");
+        
+        Place* a = net->createPlace("a");
+        a->setOutputPlace(true);
+        Place* b = net->createPlace("b");
+        b->setInputPlace(true);
+        
+        Transition* t1 = net->createTransition("t1", TimeInterval(1,2));
+        Transition* t2 = net->createTransition("t2", TimeInterval(0,0));
+        Transition* ta = net->createTransition("ta", TimeInterval(0, TimeInterval::Infinity));
+        Transition* tb = net->createTransition("tb", TimeInterval(0, TimeInterval::Infinity));
+        
+        net->connect(A, t1);
+        net->connect(t1, a);
+        net->connect(t1, B);
+        net->connect(B, t2);
+        net->connect(b, t2);
+        net->connect(t2, C);
+        net->connect(a, ta);
+        net->connect(tb, b);
+        
+        net->setInitialMarking(Marking::createMarking(1, 0, 0, 0, 0));
+        net->addFinalMarking(Marking::createMarking(0, 0, 1, 0, 0));
+        return net;
+    }
+    
+    static size_t countFinalStates(const Behavior& behavior) {
+        size_t count = 0;
+        const Behavior::StateSet& states = behavior.getStates();
+        Behavior::StateSet::const_iterator it, end;
+        for (it = states.begin(), end = states.end(); it != end; ++it) {
+            const BehaviorState* state = *it;
+            if (state->isFinal())
+                ++count;
+        }
+        return count;
+    }
+    
+    TEST(BitStateSearchTest, simpleNet) {
+        BitStateSearch::NetPtr net = createNet();
+        
+        ConstructBehavior constructBehavior;
+        Behavior::Ptr beh = constructBehavior(net);
+        
+        BitStateSearch search(16);
+        const BitStateSearch::Result result = search(net);
+        
+        ASSERT_EQ(beh->getStates().size(), result.stateCount);
+        ASSERT_EQ(countFinalStates(*beh), result.finalStateCount);
+        ASSERT_LT(0u, result.boundViolationCount);
+        ASSERT_EQ(0u, result.partialCollisionCount);
+        ASSERT_EQ(result.stateCount + result.boundViolationCount, result.storedStateCount);
+    }
+    
+    TEST(BitStateSearchTest, tinyBitArray) {
+        BitStateSearch::NetPtr net = createNet();
+        
+        ConstructBehavior constructBehavior;
+        Behavior::Ptr beh = constructBehavior(net);
+        
+        // with only two bits, every state after the first one collides with a visited state
+        BitStateSearch search(1);
+        const BitStateSearch::Result result = search(net);
+        
+        ASSERT_GE(beh->getStates().size(), result.stateCount);
+        ASSERT_EQ(2u, result.bitCount);
+        ASSERT_GE(2u, result.setBitCount);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Behavior.h"
+#include "CompressTimeChains.h"
+#include "ConstructBehavior.h"
+#include "IntervalNet.h"
+
+namespace Tippi {
+    TEST(CompressTimeChainsTest, compressChain) {
+        using Interval::Net;
+        using Interval::Place;
+        using Interval::Transition;
+        using Interval::TimeInterval;
+        
+        ConstructBehavior::NetPtr net(new Net());
+        Place* A = net->createPlace("A");
+        Place* B = net->createPlace("B");
+        Transition* t = net->createTransition("t", TimeInterval(3, 3));
+        net->connect(A, t);
+        net->connect(t, B);
+        
+        net->setInitialMarking(Marking::createMarking(1, 0));
+        net->addFinalMarking(Marking::createMarking(0, 1));
+        
+        ConstructBehavior construct;
+        Behavior::Ptr behavior = construct(net);
+        ASSERT_EQ(5u, behavior->getStates().size());
+        
+        const BehaviorState* i = behavior->getInitialState();
+        const BehaviorState* i_1 = i->findDirectSuccessor("1");
+        const BehaviorState* i_2 = i_1->findDirectSuccessor("1");
+        const BehaviorState* i_3 = i_2->findDirectSuccessor("1");
+        const size_t i_1_id = i_1->getId();
+        const size_t i_2_id = i_2->getId();
+        
+        CompressTimeChains::ChainMap chains;
+        CompressTimeChains compress(&chains);
+        behavior = compress(behavior);
+        
+        ASSERT_EQ(3u, behavior->getStates().size());
+        ASSERT_EQ(1u, i->getOutgoing().size());
+        ASSERT_EQ(i_3, i->findDirectSuccessor("1^3"));
+        ASSERT_TRUE(i->findDirectSuccessor("3") == NULL);
+        ASSERT_TRUE(i_3->findDirectSuccessor("t") != NULL);
+        
+        // the final state has a time loop, which is not a chain
+        const BehaviorState* f = i_3->findDirectSuccessor("t");
+        ASSERT_EQ(f, f->findDirectSuccessor("1"));
+        
+        ASSERT_EQ(1u, chains.size());
+        const BehaviorEdge* edge = i->getOutgoing().front();
+        const CompressTimeChains::Chain& chain = chains[edge];
+        ASSERT_EQ(2u, chain.size());
+        ASSERT_EQ(i_1_id, chain[0].id);
+        ASSERT_EQ(i_2_id, chain[1].id);
+        ASSERT_TRUE(chain[0].netState.hasTimeMarking(Marking::createMarking(1)));
+        ASSERT_TRUE(chain[1].netState.hasTimeMarking(Marking::createMarking(2)));
+    }
+}
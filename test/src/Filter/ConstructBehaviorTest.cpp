@@ -236,4 +236,75 @@ namespace Tippi {
         ASSERT_EQ(beh->findOrCreateBoundViolationState(), i_12_t1_ta_tb_t2_tb->findDirectSuccessor("tb"));
         ASSERT_EQ(i_12_t1_ta_tb_t2_tb, i_12_t1_ta_tb_t2_tb->findDirectSuccessor("1"));
     }
+    
+    TEST(ConstructBehaviorTest, partialOrderReduction) {
+        using Interval::Net;
+        using Interval::Place;
+        using Interval::Transition;
+        using Interval::TimeInterval;
+        
+        // three independent urgent unobservable transitions
+        static const String names[] = { "1", "2", "3" };
+        ConstructBehavior::NetPtr net(new Net());
+        for (size_t i = 0; i < 3; ++i) {
+            Place* A = net->createPlace("A" + names[i]);
+            Place* B = net->createPlace("B" + names[i]);
+            Transition* t = net->createTransition("t" + names[i], TimeInterval(0, 0));
+            t->setLabel("");
+            net->connect(A, t);
+            net->connect(t, B);
+        }
+        
+        net->setInitialMarking(Marking::createMarking(1, 0, 1, 0, 1, 0));
+        net->addFinalMarking(Marking::createMarking(0, 1, 0, 1, 0, 1));
+        
+        ConstructBehavior constructFull;
+        Behavior::Ptr full = constructFull(net);
+        ASSERT_EQ(8u, full->getStates().size());
+        
+        ConstructBehavior constructReduced;
+        constructReduced.usePartialOrderReduction();
+        Behavior::Ptr reduced = constructReduced(net);
+        ASSERT_EQ(4u, reduced->getStates().size());
+        
+        const BehaviorState* state = reduced->getInitialState();
+        for (size_t i = 0; i < 3; ++i) {
+            ASSERT_FALSE(state->isFinal());
+            ASSERT_EQ(1u, state->getOutgoing().size());
+            state = state->getOutgoing().front()->getTarget();
+        }
+        ASSERT_TRUE(state->isFinal());
+    }
+    
+    TEST(ConstructBehaviorTest, partialOrderReductionPreservesBoundViolations) {
+        using Interval::Net;
+        using Interval::Place;
+        using Interval::Transition;
+        using Interval::TimeInterval;
+        
+        // t1 is urgent, but t2 may refill its preset before it fires
+        ConstructBehavior::NetPtr net(new Net());
+        Place* A = net->createPlace("A");
+        Place* B = net->createPlace("B");
+        Place* C = net->createPlace("C");
+        Transition* t1 = net->createTransition("t1", TimeInterval(0, 0));
+        Transition* t2 = net->createTransition("t2", TimeInterval(0, 0));
+        t1->setLabel("");
+        net->connect(A, t1);
+        net->connect(t1, B);
+        net->connect(C, t2);
+        net->connect(t2, A);
+        
+        net->setInitialMarking(Marking::createMarking(1, 0, 1));
+        net->addFinalMarking(Marking::createMarking(0, 1, 0));
+        
+        ConstructBehavior constructReduced;
+        constructReduced.createBoundViolationState();
+        constructReduced.usePartialOrderReduction();
+        Behavior::Ptr reduced = constructReduced(net);
+        
+        const BehaviorState* i = reduced->getInitialState();
+        ASSERT_EQ(2u, i->getOutgoing().size());
+        ASSERT_EQ(reduced->findOrCreateBoundViolationState(), i->findDirectSuccessor("t2"));
+    }
 }
@@ -23,6 +23,8 @@
 #include "IntervalNet.h"
 #include "Closure.h"
 
+#include <type_traits>
+
 namespace Tippi {
     static bool hasMarking(const ClosureState* state,
                     const size_t A, const size_t B, const size_t C, const size_t D, const size_t a, const size_t b,
@@ -682,4 +684,10 @@ namespace Tippi {
         ASSERT_EQ(i_2_as_1_ar_bs_2, i_2_as_1_bs_2->findDirectSuccessor("a?"));
         ASSERT_EQ(i_bs_2_as_2_br, i_2_as_1_bs_2->findDirectSuccessor("b?"));
     }
+    
+    TEST(ConstructClosureAutomatonTest, successorsAreNothrowMovable) {
+        ASSERT_TRUE(std::is_nothrow_move_constructible<Interval::NetState::Set>::value);
+        ASSERT_TRUE(std::is_nothrow_move_constructible<Closure>::value);
+        ASSERT_TRUE(std::is_nothrow_move_constructible<ConstructClosureAutomaton::Successor>::value);
+    }
 }
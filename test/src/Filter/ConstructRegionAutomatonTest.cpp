@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Closure.h"
+#include "ConstructClosureAutomaton.h"
+#include "ConstructRegionAutomaton.h"
+#include "IntervalNet.h"
+#include "IntervalNetState.h"
+#include "Region.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace Tippi {
+    static ClosureState* createClosureState(ClosureAutomaton& automaton, const size_t marking) {
+        Closure closure;
+        closure.addState(Interval::NetState(Marking::createMarking(marking), Marking::createMarking(0)));
+        return automaton.createState(closure);
+    }
+    
+    TEST(ConstructRegionAutomatonTest, buildRegions) {
+        ClosureAutomaton::Ptr closureAutomaton(new ClosureAutomaton());
+        
+        std::vector<ClosureState*> states;
+        for (size_t i = 0; i < 7; ++i)
+            states.push_back(createClosureState(*closureAutomaton, i));
+        ClosureState* empty = closureAutomaton->createState(Closure());
+        closureAutomaton->setInitialState(states[0]);
+        
+        // region {0, 1, 2}
+        closureAutomaton->connectWithObservableEdge(states[0], states[1], "1", ClosureEdge::EdgeType_Time);
+        closureAutomaton->connectWithObservableEdge(states[2], states[1], "a!", ClosureEdge::EdgeType_OutputSend);
+        // region {3, 4}, which is not joined with region {5, 6} by the empty state
+        closureAutomaton->connectWithObservableEdge(states[3], states[4], "1", ClosureEdge::EdgeType_Time);
+        closureAutomaton->connectWithObservableEdge(states[4], empty, "b?", ClosureEdge::EdgeType_InputRead);
+        closureAutomaton->connectWithObservableEdge(empty, states[5], "1", ClosureEdge::EdgeType_Time);
+        // region {5, 6}, which is not reachable
+        closureAutomaton->connectWithObservableEdge(states[5], states[6], "1", ClosureEdge::EdgeType_Time);
+        
+        closureAutomaton->connectWithObservableEdge(states[1], states[3], "x!", ClosureEdge::EdgeType_InputSend);
+        closureAutomaton->connectWithObservableEdge(states[4], states[0], "y?", ClosureEdge::EdgeType_OutputRead);
+        closureAutomaton->connectWithObservableEdge(states[0], empty, "z!", ClosureEdge::EdgeType_InputSend);
+        closureAutomaton->connectWithObservableEdge(states[5], states[3], "x!", ClosureEdge::EdgeType_InputSend);
+        
+        const RegionAutomaton::Ptr regionAutomaton = ConstructRegionAutomaton()(closureAutomaton);
+        ASSERT_EQ(2u, regionAutomaton->getStates().size());
+        ASSERT_EQ(2u, regionAutomaton->getEdges().size());
+        
+        const RegionState* first = regionAutomaton->findRegion(states[0]);
+        ASSERT_TRUE(first != NULL);
+        ASSERT_EQ(3u, first->getRegion().size());
+        ASSERT_EQ(first, regionAutomaton->findRegion(states[1]));
+        ASSERT_EQ(first, regionAutomaton->findRegion(states[2]));
+        
+        const RegionState* second = regionAutomaton->findRegion(states[3]);
+        ASSERT_TRUE(second != NULL);
+        ASSERT_NE(first, second);
+        ASSERT_EQ(2u, second->getRegion().size());
+        ASSERT_EQ(second, regionAutomaton->findRegion(states[4]));
+        
+        ASSERT_TRUE(regionAutomaton->findRegion(states[5]) == NULL);
+        ASSERT_TRUE(regionAutomaton->findRegion(states[6]) == NULL);
+        ASSERT_TRUE(regionAutomaton->findRegion(empty) == NULL);
+        
+        ASSERT_EQ(1u, first->getOutgoing().size());
+        ASSERT_EQ(second, first->getOutgoing().front()->getTarget());
+        ASSERT_EQ(Label("x!"), first->getOutgoing().front()->getLabel());
+        ASSERT_EQ(1u, second->getOutgoing().size());
+        ASSERT_EQ(first, second->getOutgoing().front()->getTarget());
+    }
+    
+    TEST(ConstructRegionAutomatonTest, buildLargeRegion) {
+        ClosureAutomaton::Ptr closureAutomaton(new ClosureAutomaton());
+        
+        const size_t count = 100000;
+        ClosureState* previous = createClosureState(*closureAutomaton, 0);
+        closureAutomaton->setInitialState(previous);
+        for (size_t i = 1; i < count; ++i) {
+            ClosureState* state = createClosureState(*closureAutomaton, i);
+            closureAutomaton->connectWithObservableEdge(previous, state, "1", ClosureEdge::EdgeType_Time);
+            previous = state;
+        }
+        
+        const RegionAutomaton::Ptr regionAutomaton = ConstructRegionAutomaton()(closureAutomaton);
+        ASSERT_EQ(1u, regionAutomaton->getStates().size());
+        ASSERT_EQ(count, regionAutomaton->findRegion(previous)->getRegion().size());
+    }
+    
+    typedef std::set<std::pair<Label, RegionState::Fingerprint> > SuccessorSet;
+    
+    static SuccessorSet getSuccessors(const RegionState* region) {
+        SuccessorSet result;
+        const RegionEdge::List& outgoing = region->getOutgoing();
+        RegionEdge::List::const_iterator it, end;
+        for (it = outgoing.begin(), end = outgoing.end(); it != end; ++it) {
+            const RegionEdge* edge = *it;
+            result.insert(std::make_pair(edge->getLabel(), edge->getTarget()->getFingerprint()));
+        }
+        return result;
+    }
+    
+    TEST(ConstructRegionAutomatonTest, buildFromNet) {
+        using Interval::Net;
+        using Interval::Place;
+        using Interval::Transition;
+        using Interval::TimeInterval;
+        
+        ConstructRegionAutomaton::NetPtr net(new Net());
+        
+        Place* A = net->createPlace("A");
+        Place* B = net->createPlace("B");
+        Place* C = net->createPlace("C");
+        Place* D = net->createPlace("D");
+        
+        Place* a = net->createPlace("a");
+        a->setOutputPlace(true);
+        Place* b = net->createPlace("b");
+        b->setInputPlace(true);
+        
+        Transition* t1 = net->createTransition("a!", TimeInterval(2,3));
+        Transition* t2 = net->createTransition("", TimeInterval(3,4));
+        Transition* t3 = net->createTransition("b?", TimeInterval(1,2));
+        Transition* ta = net->createTransition("a?", TimeInterval(0, TimeInterval::Infinity));
+        Transition* tb = net->createTransition("b!", TimeInterval(0, TimeInterval::Infinity));
+        
+        net->connect(A, t1);
+        net->connect(t1, a);
+        net->connect(t1, B);
+        net->connect(B, t2);
+        net->connect(B, t3);
+        net->connect(t2, C);
+        net->connect(b, t3);
+        net->connect(t3, D);
+        net->connect(a, ta);
+        net->connect(tb, b);
+        
+        net->setInitialMarking(Marking::createMarking(1, 0, 0, 0, 0, 0));
+        net->addFinalMarking(Marking::createMarking(0, 0, 0, 1, 0, 0));
+        
+        const ClosureAutomaton::Ptr closureAutomaton = ConstructClosureAutomaton()(net);
+        const RegionAutomaton::Ptr expected = ConstructRegionAutomaton()(closureAutomaton);
+        const RegionAutomaton::Ptr actual = ConstructRegionAutomaton()(net);
+        
+        ASSERT_LT(1u, expected->getStates().size());
+        ASSERT_EQ(expected->getStates().size(), actual->getStates().size());
+        ASSERT_EQ(expected->getEdges().size(), actual->getEdges().size());
+        ASSERT_EQ(expected->getFinalStates().size(), actual->getFinalStates().size());
+        
+        // the regions built from the net do not store their closures, so they are matched by their fingerprints
+        std::map<RegionState::Fingerprint, const RegionState*> actualRegions;
+        RegionAutomaton::StateSet::const_iterator sIt, sEnd;
+        for (sIt = actual->getStates().begin(), sEnd = actual->getStates().end(); sIt != sEnd; ++sIt) {
+            const RegionState* region = *sIt;
+            ASSERT_TRUE(region->getRegion().empty());
+            ASSERT_TRUE(actualRegions.insert(std::make_pair(region->getFingerprint(), region)).second);
+        }
+        
+        ASSERT_EQ(expected->getInitialState()->getFingerprint(), actual->getInitialState()->getFingerprint());
+        for (sIt = expected->getStates().begin(), sEnd = expected->getStates().end(); sIt != sEnd; ++sIt) {
+            const RegionState* expectedRegion = *sIt;
+            const RegionState* actualRegion = actualRegions[expectedRegion->getFingerprint()];
+            ASSERT_TRUE(actualRegion != NULL);
+            ASSERT_EQ(expectedRegion->getClosureCount(), actualRegion->getClosureCount());
+            ASSERT_EQ(expectedRegion->isFinal(), actualRegion->isFinal());
+            ASSERT_EQ(getSuccessors(expectedRegion), getSuccessors(actualRegion));
+        }
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Closure.h"
+#include "IntervalNetState.h"
+#include "MarkUnsafeStates.h"
+
+namespace Tippi {
+    static Closure createClosure(const size_t marking) {
+        Closure closure;
+        closure.addState(Interval::NetState(Marking::createMarking(marking), Marking::createMarking(0)));
+        return closure;
+    }
+    
+    static ClosureState* createClosureState(ClosureAutomaton& automaton, const size_t marking) {
+        return automaton.createState(createClosure(marking));
+    }
+    
+    static ClosureState* createFinalState(ClosureAutomaton& automaton, const size_t marking) {
+        ClosureState* state = createClosureState(automaton, marking);
+        state->setFinal(true);
+        automaton.addFinalState(state);
+        return state;
+    }
+    
+    static ClosureState* createLoopState(ClosureAutomaton& automaton, const size_t marking) {
+        Closure closure = createClosure(marking);
+        closure.setContainsLoop();
+        return automaton.createState(std::move(closure));
+    }
+    
+    static bool isUnknown(const ClosureState* state) {
+        return !state->isSafetyKnown();
+    }
+    
+    static bool isSafe(const ClosureState* state) {
+        return state->isSafetyKnown() && state->isSafe();
+    }
+    
+    static bool isUnsafe(const ClosureState* state) {
+        return state->isSafetyKnown() && !state->isSafe();
+    }
+    
+    TEST(MarkUnsafeStatesTest, markDeadEndComponents) {
+        ClosureAutomaton::Ptr automaton(new ClosureAutomaton());
+        ClosureState* i = createClosureState(*automaton, 0);
+        ClosureState* c1 = createClosureState(*automaton, 1);
+        ClosureState* c2 = createClosureState(*automaton, 2);
+        ClosureState* f1 = createFinalState(*automaton, 3);
+        ClosureState* f2 = createFinalState(*automaton, 4);
+        ClosureState* x = createClosureState(*automaton, 5);
+        ClosureState* empty = automaton->createState(Closure());
+        automaton->setInitialState(i);
+        
+        // the cycle {c1, c2} cannot be left
+        automaton->connectWithObservableEdge(i, c1, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(c1, c2, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(c2, c1, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(c2, empty, "b?", ClosureEdge::EdgeType_InputRead);
+        
+        // final states are never dead ends, and neither are the components that contain one
+        automaton->connectWithObservableEdge(i, f1, "a!", ClosureEdge::EdgeType_OutputSend);
+        automaton->connectWithObservableEdge(i, f2, "b?", ClosureEdge::EdgeType_InputRead);
+        automaton->connectWithObservableEdge(f2, x, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(x, f2, "a?", ClosureEdge::EdgeType_OutputRead);
+        
+        MarkUnsafeStates mark;
+        mark(automaton);
+        
+        ASSERT_TRUE(isUnsafe(c1));
+        ASSERT_TRUE(isUnsafe(c2));
+        
+        // no successor of the initial state is known to be safe when its component is visited
+        ASSERT_TRUE(isUnsafe(i));
+        
+        // the final states are only determined when the safety of a successor is propagated
+        ASSERT_TRUE(isUnknown(f1));
+        ASSERT_TRUE(isUnknown(f2));
+        ASSERT_TRUE(isUnknown(x));
+        ASSERT_TRUE(empty->isSafetyKnown());
+        ASSERT_TRUE(empty->isSafe());
+    }
+    
+    TEST(MarkUnsafeStatesTest, propagateSafety) {
+        ClosureAutomaton::Ptr automaton(new ClosureAutomaton());
+        
+        // the initial state is final and isolated, so every other state is unreachable and is
+        // only determined by the propagation
+        ClosureState* i = createFinalState(*automaton, 0);
+        automaton->setInitialState(i);
+        
+        ClosureState* d = createLoopState(*automaton, 1);
+        ClosureState* service = createClosureState(*automaton, 2);
+        ClosureState* partner = createClosureState(*automaton, 3);
+        ClosureState* partnerWithTime = createClosureState(*automaton, 4);
+        ClosureState* time = createClosureState(*automaton, 5);
+        ClosureState* timeChain = createClosureState(*automaton, 6);
+        ClosureState* mixed = createClosureState(*automaton, 7);
+        ClosureState* unstableFinal = createFinalState(*automaton, 8);
+        ClosureState* stableFinal = createFinalState(*automaton, 9);
+        ClosureState* safeService = createClosureState(*automaton, 10);
+        
+        // d is a deadlock with an inner livelock
+        automaton->connectWithObservableEdge(d, d, "1", ClosureEdge::EdgeType_Time);
+        
+        // a service action to an unsafe state makes the source unsafe
+        automaton->connectWithObservableEdge(service, d, "b?", ClosureEdge::EdgeType_InputRead);
+        
+        // a partner action to an unsafe state makes the source unsafe only if it can let time pass
+        automaton->connectWithObservableEdge(partner, d, "a!", ClosureEdge::EdgeType_InputSend);
+        automaton->connectWithObservableEdge(partnerWithTime, d, "a!", ClosureEdge::EdgeType_InputSend);
+        automaton->connectWithObservableEdge(partnerWithTime, partnerWithTime, "1", ClosureEdge::EdgeType_Time);
+        
+        // time steps to unsafe states propagate along chains
+        automaton->connectWithObservableEdge(time, d, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(timeChain, time, "1", ClosureEdge::EdgeType_Time);
+        
+        // a safe partner successor outweighs an unsafe time successor
+        automaton->connectWithObservableEdge(mixed, d, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(mixed, partner, "a!", ClosureEdge::EdgeType_InputSend);
+        
+        // a final state is safe if it is stable
+        automaton->connectWithObservableEdge(unstableFinal, d, "a!", ClosureEdge::EdgeType_OutputSend);
+        automaton->connectWithObservableEdge(stableFinal, d, "a?", ClosureEdge::EdgeType_OutputRead);
+        
+        // a service action to a safe state is safe
+        automaton->connectWithObservableEdge(safeService, stableFinal, "b?", ClosureEdge::EdgeType_InputRead);
+        
+        MarkUnsafeStates mark;
+        mark(automaton);
+        
+        ASSERT_TRUE(isUnknown(i));
+        ASSERT_TRUE(isUnsafe(d));
+        ASSERT_TRUE(isUnsafe(service));
+        ASSERT_TRUE(isSafe(partner));
+        ASSERT_TRUE(isUnsafe(partnerWithTime));
+        ASSERT_TRUE(isUnsafe(time));
+        ASSERT_TRUE(isUnsafe(timeChain));
+        ASSERT_TRUE(isSafe(mixed));
+        ASSERT_TRUE(isUnsafe(unstableFinal));
+        ASSERT_TRUE(isSafe(stableFinal));
+        ASSERT_TRUE(isSafe(safeService));
+    }
+    
+    TEST(MarkUnsafeStatesTest, propagateThroughCycles) {
+        ClosureAutomaton::Ptr automaton(new ClosureAutomaton());
+        ClosureState* i = createFinalState(*automaton, 0);
+        automaton->setInitialState(i);
+        
+        Closure bvClosure = createClosure(1);
+        bvClosure.setContainsBoundViolation();
+        ClosureState* bv = automaton->boundViolationState(std::move(bvClosure));
+        
+        // the cycle {c1, c2} becomes unsafe through the service action of c2
+        ClosureState* c1 = createClosureState(*automaton, 2);
+        ClosureState* c2 = createClosureState(*automaton, 3);
+        automaton->connectWithObservableEdge(c1, c2, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(c2, c1, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(c2, bv, "a!", ClosureEdge::EdgeType_OutputSend);
+        
+        // the cycle {u1, u2} only has a partner action to an unsafe state, so it stays unknown
+        ClosureState* u1 = createClosureState(*automaton, 4);
+        ClosureState* u2 = createClosureState(*automaton, 5);
+        automaton->connectWithObservableEdge(u1, u2, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(u2, u1, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(u1, c1, "b!", ClosureEdge::EdgeType_InputSend);
+        
+        MarkUnsafeStates mark;
+        mark(automaton);
+        
+        ASSERT_TRUE(isUnsafe(bv));
+        ASSERT_TRUE(isUnsafe(c1));
+        ASSERT_TRUE(isUnsafe(c2));
+        ASSERT_TRUE(isUnknown(u1));
+        ASSERT_TRUE(isUnknown(u2));
+    }
+}
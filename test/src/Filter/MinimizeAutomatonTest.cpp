@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Behavior.h"
+#include "IntervalNetState.h"
+#include "MinimizeAutomaton.h"
+
+namespace Tippi {
+    static BehaviorState* createState(Behavior& behavior, const size_t tokens) {
+        const Interval::NetState netState(Marking::createMarking(tokens), Marking::createMarking(0));
+        return behavior.createState(netState);
+    }
+    
+    TEST(MinimizeAutomatonTest, minimizeBehavior) {
+        // i -a-> s1 -b-> f1, i -a-> s2 -b-> f2, where f1 and f2 are final
+        Behavior::Ptr behavior(new Behavior());
+        BehaviorState* i = createState(*behavior, 0);
+        BehaviorState* s1 = createState(*behavior, 1);
+        BehaviorState* s2 = createState(*behavior, 2);
+        BehaviorState* f1 = createState(*behavior, 3);
+        BehaviorState* f2 = createState(*behavior, 4);
+        behavior->setInitialState(i);
+        f1->setFinal(true);
+        behavior->addFinalState(f1);
+        f2->setFinal(true);
+        behavior->addFinalState(f2);
+        behavior->connectWithObservableEdge(i, s1, "a");
+        behavior->connectWithObservableEdge(i, s2, "a");
+        behavior->connectWithObservableEdge(s1, f1, "b");
+        behavior->connectWithObservableEdge(s2, f2, "b");
+        
+        MinimizeAutomaton minimize;
+        behavior = minimize(behavior);
+        
+        ASSERT_EQ(3u, behavior->getStates().size());
+        ASSERT_EQ(i, behavior->getInitialState());
+        ASSERT_EQ(1u, i->getOutgoing().size());
+        
+        const BehaviorState* s = i->findDirectSuccessor("a");
+        ASSERT_TRUE(s != NULL);
+        ASSERT_EQ(1u, s->getOutgoing().size());
+        
+        const BehaviorState* f = s->findDirectSuccessor("b");
+        ASSERT_TRUE(f != NULL);
+        ASSERT_TRUE(f->isFinal());
+        ASSERT_TRUE(f->getOutgoing().empty());
+    }
+    
+    TEST(MinimizeAutomatonTest, keepFinalStates) {
+        // i -a-> s, i -a-> f, where only f is final
+        Behavior::Ptr behavior(new Behavior());
+        BehaviorState* i = createState(*behavior, 0);
+        BehaviorState* s = createState(*behavior, 1);
+        BehaviorState* f = createState(*behavior, 2);
+        behavior->setInitialState(i);
+        f->setFinal(true);
+        behavior->addFinalState(f);
+        behavior->connectWithObservableEdge(i, s, "a");
+        behavior->connectWithObservableEdge(i, f, "a");
+        
+        MinimizeAutomaton minimize;
+        behavior = minimize(behavior);
+        ASSERT_EQ(3u, behavior->getStates().size());
+        ASSERT_EQ(2u, i->getOutgoing().size());
+    }
+    
+    TEST(MinimizeAutomatonTest, mergeIntoInitialState) {
+        // i -a-> s -a-> s, so i and s are bisimilar
+        Behavior::Ptr behavior(new Behavior());
+        BehaviorState* i = createState(*behavior, 0);
+        BehaviorState* s = createState(*behavior, 1);
+        behavior->setInitialState(i);
+        behavior->connectWithObservableEdge(i, s, "a");
+        behavior->connectWithObservableEdge(s, s, "a");
+        
+        MinimizeAutomaton minimize;
+        behavior = minimize(behavior);
+        ASSERT_EQ(1u, behavior->getStates().size());
+        ASSERT_EQ(i, behavior->getInitialState());
+        ASSERT_EQ(i, i->findDirectSuccessor("a"));
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Closure.h"
+#include "IntervalNetState.h"
+#include "RemoveUnreachableStates.h"
+
+#include <algorithm>
+
+namespace Tippi {
+    static ClosureState* createClosureState(ClosureAutomaton& automaton, const size_t marking) {
+        Closure closure;
+        closure.addState(Interval::NetState(Marking::createMarking(marking), Marking::createMarking(0)));
+        return automaton.createState(closure);
+    }
+    
+    TEST(RemoveUnreachableStatesTest, removeUnreachableCycle) {
+        ClosureAutomaton::Ptr automaton(new ClosureAutomaton());
+        ClosureState* i = createClosureState(*automaton, 0);
+        ClosureState* r = createClosureState(*automaton, 1);
+        ClosureState* u1 = createClosureState(*automaton, 2);
+        ClosureState* u2 = createClosureState(*automaton, 3);
+        ClosureState* u3 = createClosureState(*automaton, 4);
+        automaton->setInitialState(i);
+        
+        automaton->connectWithObservableEdge(i, r, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(r, i, "a!", ClosureEdge::EdgeType_InputSend);
+        
+        // the cycle {u1, u2, u3} leads into the reachable states but cannot be reached itself
+        automaton->connectWithObservableEdge(u1, u2, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(u2, u3, "1", ClosureEdge::EdgeType_Time);
+        automaton->connectWithObservableEdge(u3, u1, "b?", ClosureEdge::EdgeType_InputRead);
+        automaton->connectWithObservableEdge(u2, r, "a?", ClosureEdge::EdgeType_OutputRead);
+        
+        const ClosureAutomaton::StateList unreachable = automaton->findUnreachableStates();
+        ASSERT_EQ(3u, unreachable.size());
+        ASSERT_TRUE(std::find(unreachable.begin(), unreachable.end(), u1) != unreachable.end());
+        ASSERT_TRUE(std::find(unreachable.begin(), unreachable.end(), u2) != unreachable.end());
+        ASSERT_TRUE(std::find(unreachable.begin(), unreachable.end(), u3) != unreachable.end());
+        
+        RemoveUnreachableStates remove;
+        automaton = remove(automaton);
+        
+        ASSERT_EQ(2u, automaton->getStates().size());
+        ASSERT_EQ(2u, automaton->getEdges().size());
+        ASSERT_EQ(1u, r->getIncoming().size());
+        ASSERT_TRUE(automaton->findUnreachableStates().empty());
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Behavior.h"
+#include "FrozenAutomaton.h"
+#include "IntervalNetState.h"
+
+#include <vector>
+
+namespace Tippi {
+    TEST(FrozenAutomatonTest, freezeBehavior) {
+        Behavior behavior;
+        
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 5; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        behavior.setInitialState(states[2]);
+        states[1]->setFinal(true);
+        behavior.addFinalState(states[1]);
+        
+        // 2 -> 0 -> 1, 2 -> 1, 1 -> 2, 3 -> 2, 4 isolated
+        behavior.connectWithObservableEdge(states[2], states[0], "a");
+        behavior.connectWithUnobservableEdge(states[2], states[1]);
+        behavior.connectWithObservableEdge(states[0], states[1], "b");
+        behavior.connectWithObservableEdge(states[1], states[2], "c");
+        behavior.connectWithObservableEdge(states[3], states[2], "d");
+        
+        const FrozenAutomaton<BehaviorState, BehaviorEdge> frozen = behavior.freeze();
+        ASSERT_EQ(5u, frozen.getStateCount());
+        ASSERT_EQ(3u, frozen.getReachableCount());
+        ASSERT_EQ(5u, frozen.getEdgeCount());
+        
+        // the reachable states are numbered in breadth first order, the others follow
+        ASSERT_EQ(states[2], frozen.getState(0));
+        ASSERT_EQ(0u, frozen.getIndex(states[2]));
+        ASSERT_TRUE(frozen.isReachable(2));
+        ASSERT_FALSE(frozen.isReachable(3));
+        ASSERT_EQ(states[3], frozen.getState(3));
+        ASSERT_EQ(states[4], frozen.getState(4));
+        
+        const size_t index0 = frozen.getIndex(states[0]);
+        const size_t index1 = frozen.getIndex(states[1]);
+        ASSERT_TRUE(frozen.isFinal(index1));
+        ASSERT_FALSE(frozen.isFinal(index0));
+        
+        const FrozenAutomaton<BehaviorState, BehaviorEdge>::EdgeRange successors = frozen.getSuccessors(0);
+        ASSERT_EQ(2u, successors.second - successors.first);
+        ASSERT_EQ(index0, frozen.getSuccessor(successors.first));
+        ASSERT_EQ(Label("a"), frozen.getSuccessorLabel(successors.first));
+        ASSERT_EQ(1u, frozen.getSuccessorType(successors.first));
+        ASSERT_EQ(index1, frozen.getSuccessor(successors.first + 1));
+        ASSERT_EQ(0u, frozen.getSuccessorType(successors.first + 1));
+        
+        const FrozenAutomaton<BehaviorState, BehaviorEdge>::EdgeRange predecessors = frozen.getPredecessors(0);
+        ASSERT_EQ(2u, predecessors.second - predecessors.first);
+        ASSERT_EQ(index1, frozen.getPredecessor(predecessors.first));
+        ASSERT_EQ(3u, frozen.getPredecessor(predecessors.first + 1));
+        ASSERT_EQ(states[3], frozen.getPredecessorEdge(predecessors.first + 1)->getSource());
+        
+        const FrozenAutomaton<BehaviorState, BehaviorEdge>::EdgeRange isolated = frozen.getSuccessors(4);
+        ASSERT_EQ(isolated.first, isolated.second);
+    }
+    
+    TEST(FrozenAutomatonTest, freezeWithoutInitialState) {
+        Behavior behavior;
+        behavior.createState(Interval::NetState(Marking::createMarking(0), Marking::createMarking(0)));
+        
+        const FrozenAutomaton<BehaviorState, BehaviorEdge> frozen = behavior.freeze();
+        ASSERT_EQ(1u, frozen.getStateCount());
+        ASSERT_EQ(0u, frozen.getReachableCount());
+    }
+}
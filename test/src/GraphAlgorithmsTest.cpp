@@ -0,0 +1,270 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Behavior.h"
+#include "GraphAlgorithms.h"
+#include "IntervalNet.h"
+#include "IntervalNetState.h"
+
+#include <vector>
+
+namespace Tippi {
+    struct CollectingVisitor {
+        std::vector<const BehaviorState*> states;
+        std::vector<const BehaviorEdge*> edges;
+        
+        void visitNode(const BehaviorState* state) {
+            states.push_back(state);
+        }
+        
+        void visitEdge(const BehaviorEdge* edge) {
+            edges.push_back(edge);
+        }
+    };
+    
+    struct OrderVisitor {
+        std::vector<size_t> initialized;
+        std::vector<size_t> visited;
+        std::vector<String> edges;
+        size_t limit;
+        
+        OrderVisitor(const size_t i_limit = 0) :
+        limit(i_limit) {}
+        
+        void initNode(const BehaviorState* state) {
+            initialized.push_back(state->getId());
+        }
+        
+        bool visitNode(const BehaviorState* state) {
+            visited.push_back(state->getId());
+            return limit == 0 || visited.size() < limit;
+        }
+        
+        void visitEdge(const BehaviorEdge* edge) {
+            edges.push_back(edge->getLabel().getName());
+        }
+    };
+    
+    struct NetVisitor {
+        std::vector<String> nodes;
+        size_t edges;
+        
+        NetVisitor() :
+        edges(0) {}
+        
+        void visitNode(const Interval::Place* place) {
+            nodes.push_back(place->getName());
+        }
+        
+        void visitNode(const Interval::Transition* transition) {
+            nodes.push_back(transition->getName());
+        }
+        
+        template <typename Edge>
+        void visitEdge(const Edge*) {
+            ++edges;
+        }
+    };
+    
+    struct NetNodeKey {
+        size_t operator()(const Interval::Place* place) const {
+            return 2 * place->getIndex();
+        }
+        
+        size_t operator()(const Interval::Transition* transition) const {
+            return 2 * transition->getIndex() + 1;
+        }
+    };
+    
+    /**
+     Creates the following behavior, where the edges are labeled with the ids of their source and
+     target:
+     
+     1 -> 2 -> 4
+     1 -> 3 -> 4 -> 1
+     */
+    static std::vector<BehaviorState*> createDiamond(Behavior& behavior) {
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 4; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        behavior.connectWithObservableEdge(states[0], states[1], "12");
+        behavior.connectWithObservableEdge(states[0], states[2], "13");
+        behavior.connectWithObservableEdge(states[1], states[3], "24");
+        behavior.connectWithObservableEdge(states[2], states[3], "34");
+        behavior.connectWithObservableEdge(states[3], states[0], "41");
+        return states;
+    }
+    
+    TEST(GraphAlgorithmsTest, breadthFirstOrder) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createDiamond(behavior);
+        
+        OrderVisitor visitor;
+        VisitedSet<> visited;
+        ASSERT_TRUE(breadthFirst(states[0], visitor, visitor, visited));
+        
+        const size_t expectedNodes[] = { 1, 2, 3, 4 };
+        const String expectedEdges[] = { "12", "13", "24", "34", "41" };
+        ASSERT_EQ(std::vector<size_t>(expectedNodes, expectedNodes + 4), visitor.visited);
+        ASSERT_EQ(std::vector<String>(expectedEdges, expectedEdges + 5), visitor.edges);
+    }
+    
+    TEST(GraphAlgorithmsTest, preOrder) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createDiamond(behavior);
+        
+        OrderVisitor visitor;
+        VisitedSet<> visited;
+        ASSERT_TRUE(preOrder(states[0], visitor, visitor, visited));
+        
+        const size_t expectedNodes[] = { 1, 2, 4, 3 };
+        const String expectedEdges[] = { "12", "24", "41", "13", "34" };
+        ASSERT_EQ(std::vector<size_t>(expectedNodes, expectedNodes + 4), visitor.visited);
+        ASSERT_EQ(std::vector<String>(expectedEdges, expectedEdges + 5), visitor.edges);
+        ASSERT_TRUE(visitor.initialized.empty());
+    }
+    
+    TEST(GraphAlgorithmsTest, depthFirstOrder) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createDiamond(behavior);
+        
+        OrderVisitor visitor;
+        VisitedSet<> visited;
+        ASSERT_TRUE(depthFirst(states[0], visitor, visitor, visited));
+        
+        const size_t expectedInitialized[] = { 1, 2, 4, 3 };
+        const size_t expectedNodes[] = { 4, 2, 3, 1 };
+        const String expectedEdges[] = { "41", "24", "12", "34", "13" };
+        ASSERT_EQ(std::vector<size_t>(expectedInitialized, expectedInitialized + 4), visitor.initialized);
+        ASSERT_EQ(std::vector<size_t>(expectedNodes, expectedNodes + 4), visitor.visited);
+        ASSERT_EQ(std::vector<String>(expectedEdges, expectedEdges + 5), visitor.edges);
+    }
+    
+    TEST(GraphAlgorithmsTest, stopTraversal) {
+        Behavior behavior;
+        std::vector<BehaviorState*> states = createDiamond(behavior);
+        
+        OrderVisitor bfVisitor(2);
+        VisitedSet<> bfVisited;
+        ASSERT_FALSE(breadthFirst(states[0], bfVisitor, bfVisitor, bfVisited));
+        ASSERT_EQ(2u, bfVisitor.visited.size());
+        
+        OrderVisitor dfVisitor(3);
+        VisitedSet<> dfVisited;
+        ASSERT_FALSE(preOrder(states[0], dfVisitor, dfVisitor, dfVisited));
+        ASSERT_EQ(3u, dfVisitor.visited.size());
+        ASSERT_FALSE(dfVisited.isVisited(states[2]));
+    }
+    
+    TEST(GraphAlgorithmsTest, traverseLongChain) {
+        Behavior behavior;
+        
+        const size_t count = 100000;
+        BehaviorState* first = behavior.createState(Interval::NetState(Marking::createMarking(0), Marking::createMarking(0)));
+        BehaviorState* previous = first;
+        for (size_t i = 1; i < count; ++i) {
+            BehaviorState* state = behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0)));
+            behavior.connectWithObservableEdge(previous, state, "a");
+            previous = state;
+        }
+        
+        OrderVisitor visitor;
+        VisitedSet<> visited(behavior.getMaxId() + 1);
+        ASSERT_TRUE(depthFirst(first, visitor, visitor, visited));
+        ASSERT_EQ(count, visitor.visited.size());
+        ASSERT_EQ(previous->getId(), visitor.visited.front());
+        ASSERT_EQ(first->getId(), visitor.visited.back());
+    }
+    
+    TEST(GraphAlgorithmsTest, traverseNet) {
+        Interval::Net net;
+        Interval::Place* p1 = net.createPlace("p1");
+        Interval::Place* p2 = net.createPlace("p2");
+        Interval::Place* p3 = net.createPlace("p3");
+        Interval::Transition* t1 = net.createTransition("t1", Interval::TimeInterval());
+        Interval::Transition* t2 = net.createTransition("t2", Interval::TimeInterval());
+        net.connect(p1, t1);
+        net.connect(t1, p2);
+        net.connect(t1, p3);
+        net.connect(p2, t2);
+        net.connect(t2, p1);
+        
+        NetVisitor bfVisitor;
+        VisitedSet<NetNodeKey> bfVisited;
+        ASSERT_TRUE(breadthFirst(p1, bfVisitor, bfVisitor, bfVisited));
+        const String expectedBf[] = { "p1", "t1", "p2", "p3", "t2" };
+        ASSERT_EQ(std::vector<String>(expectedBf, expectedBf + 5), bfVisitor.nodes);
+        ASSERT_EQ(5u, bfVisitor.edges);
+        
+        NetVisitor dfVisitor;
+        VisitedSet<NetNodeKey> dfVisited;
+        ASSERT_TRUE(preOrder(p1, dfVisitor, dfVisitor, dfVisited));
+        const String expectedDf[] = { "p1", "t1", "p2", "t2", "p3" };
+        ASSERT_EQ(std::vector<String>(expectedDf, expectedDf + 5), dfVisitor.nodes);
+        ASSERT_EQ(5u, dfVisitor.edges);
+    }
+    
+    TEST(GraphAlgorithmsTest, visitedSet) {
+        Behavior behavior;
+        const BehaviorState* state1 = behavior.createState(Interval::NetState(Marking::createMarking(1), Marking::createMarking(0)));
+        const BehaviorState* state2 = behavior.createState(Interval::NetState(Marking::createMarking(2), Marking::createMarking(0)));
+        
+        VisitedSet<> visited;
+        ASSERT_FALSE(visited.isVisited(state1));
+        ASSERT_TRUE(visited.visit(state1));
+        ASSERT_FALSE(visited.visit(state1));
+        ASSERT_TRUE(visited.isVisited(state1));
+        ASSERT_FALSE(visited.isVisited(state2));
+    }
+    
+    TEST(GraphAlgorithmsTest, independentTraversals) {
+        Behavior behavior;
+        
+        std::vector<BehaviorState*> states;
+        for (size_t i = 0; i < 4; ++i)
+            states.push_back(behavior.createState(Interval::NetState(Marking::createMarking(i), Marking::createMarking(0))));
+        
+        // 0 -> 1 -> 2 -> 0, 1 -> 3
+        behavior.connectWithObservableEdge(states[0], states[1], "a");
+        behavior.connectWithObservableEdge(states[1], states[2], "b");
+        behavior.connectWithObservableEdge(states[2], states[0], "c");
+        behavior.connectWithObservableEdge(states[1], states[3], "d");
+        
+        CollectingVisitor visitor1;
+        VisitedSet<> visited1(behavior.getMaxId() + 1);
+        BreadthFirst<CollectingVisitor, CollectingVisitor> traversal1(visitor1, visitor1, visited1);
+        
+        CollectingVisitor visitor2;
+        VisitedSet<> visited2(behavior.getMaxId() + 1);
+        BreadthFirst<CollectingVisitor, CollectingVisitor> traversal2(visitor2, visitor2, visited2);
+        
+        // the second traversal is not affected by the nodes which the first one has visited
+        traversal1(states[1]);
+        traversal2(states[0]);
+        
+        ASSERT_EQ(4u, visitor1.states.size());
+        ASSERT_EQ(4u, visitor1.edges.size());
+        ASSERT_EQ(4u, visitor2.states.size());
+        ASSERT_EQ(4u, visitor2.edges.size());
+        ASSERT_EQ(states[1], visitor1.states.front());
+        ASSERT_EQ(states[0], visitor2.states.front());
+    }
+}
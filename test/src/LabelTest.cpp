@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Label.h"
+
+#include <thread>
+#include <vector>
+
+namespace Tippi {
+    TEST(LabelTest, intern) {
+        const Label empty;
+        ASSERT_TRUE(empty.empty());
+        ASSERT_EQ(0u, empty.getIndex());
+        ASSERT_EQ(empty, Label(""));
+        ASSERT_EQ(empty, Label(String()));
+        
+        const Label a("a");
+        const Label b(String("b"));
+        ASSERT_FALSE(a.empty());
+        ASSERT_NE(a, b);
+        ASSERT_EQ(a, Label("a"));
+        ASSERT_EQ(a.getIndex(), Label(String("a")).getIndex());
+        ASSERT_EQ(String("a"), a.getName());
+        ASSERT_EQ(String("b"), b.getName());
+    }
+    
+    TEST(LabelTest, compare) {
+        const Label z("compare_z");
+        const Label y("compare_y");
+        ASSERT_TRUE(z < y);
+        ASSERT_GT(z.compare(y), 0);
+        ASSERT_LT(y.compare(z), 0);
+        ASSERT_EQ(0, z.compare(Label("compare_z")));
+    }
+    
+    TEST(LabelTest, find) {
+        const size_t count = Label::count();
+        
+        Label label;
+        ASSERT_FALSE(Label::find("find_unknown", label));
+        ASSERT_EQ(count, Label::count());
+        
+        ASSERT_TRUE(Label::find("", label));
+        ASSERT_TRUE(label.empty());
+        
+        const Label known("find_known");
+        ASSERT_TRUE(Label::find("find_known", label));
+        ASSERT_EQ(known, label);
+    }
+    
+    TEST(LabelTest, concurrentIntern) {
+        const size_t threadCount = 4;
+        const size_t labelCount = 200;
+        
+        std::vector<std::vector<size_t> > indices(threadCount);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i) {
+            threads.push_back(std::thread([i, &indices]() {
+                for (size_t j = 0; j < labelCount; ++j) {
+                    StringStream name;
+                    name << "concurrent_" << j;
+                    indices[i].push_back(Label(name.str()).getIndex());
+                }
+            }));
+        }
+        for (size_t i = 0; i < threadCount; ++i)
+            threads[i].join();
+        
+        for (size_t i = 1; i < threadCount; ++i)
+            ASSERT_EQ(indices[0], indices[i]);
+        for (size_t j = 0; j < labelCount; ++j) {
+            StringStream name;
+            name << "concurrent_" << j;
+            ASSERT_EQ(name.str(), Label(name.str()).getName());
+            ASSERT_EQ(indices[0][j], Label(name.str()).getIndex());
+        }
+    }
+    
+    TEST(LabelSetTest, contains) {
+        LabelSet labels(Label(""));
+        ASSERT_TRUE(labels.contains(Label()));
+        ASSERT_FALSE(labels.contains(Label("a")));
+        
+        labels.insert(Label("a"));
+        ASSERT_TRUE(labels.contains(Label("a")));
+        ASSERT_FALSE(labels.contains(Label("b")));
+        ASSERT_FALSE(labels.contains(Label("set_unused")));
+    }
+}
@@ -96,5 +96,32 @@ namespace Tippi {
             ASSERT_TRUE(state2Result.containsBoundViolation());
             ASSERT_FALSE(state2Result.containsLoop());
         }
+        
+        TEST(IntervalNetFiringRuleTest, buildClosureWithLoop) {
+            Net net;
+            Place* A = net.createPlace("A");
+            Place* B = net.createPlace("B");
+            Transition* t1 = net.createTransition("t1", TimeInterval(0,1));
+            Transition* t2 = net.createTransition("t2", TimeInterval(0,1));
+            
+            net.connect(A, t1);
+            net.connect(t1, B);
+            net.connect(B, t2);
+            net.connect(t2, A);
+            
+            net.setInitialMarking(Marking::createMarking(1, 0));
+            net.setTransitionLabels(LabelingFunction());
+            
+            const NetState initial = NetState::createInitialState(net);
+            const FiringRule rule(net);
+            
+            const FiringRule::Closure result = rule.buildClosure(initial);
+            const NetState::Set& closure = result.getStates();
+            ASSERT_FALSE(result.containsBoundViolation());
+            ASSERT_TRUE(result.containsLoop());
+            ASSERT_EQ(2u, closure.size());
+            ASSERT_TRUE(closure.count(initial) == 1);
+            ASSERT_TRUE(closure.count(rule.fireTransition(t1, initial)) == 1);
+        }
     }
 }
@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ObjectPool.h"
+
+#include <new>
+#include <set>
+
+namespace Tippi {
+    struct PooledObject {
+        static size_t instances;
+        double value;
+        
+        PooledObject(const double i_value) :
+        value(i_value) {
+            ++instances;
+        }
+        
+        ~PooledObject() {
+            --instances;
+        }
+    };
+    
+    size_t PooledObject::instances = 0;
+    
+    TEST(ObjectPoolTest, allocateAndDestroy) {
+        ObjectPool<PooledObject> pool(2);
+        
+        std::vector<PooledObject*> objects;
+        for (size_t i = 0; i < 10; ++i)
+            objects.push_back(new (pool.allocate()) PooledObject(static_cast<double>(i)));
+        ASSERT_EQ(10u, pool.size());
+        ASSERT_EQ(10u, PooledObject::instances);
+        
+        const std::set<PooledObject*> distinct(objects.begin(), objects.end());
+        ASSERT_EQ(10u, distinct.size());
+        for (size_t i = 0; i < 10; ++i)
+            ASSERT_EQ(static_cast<double>(i), objects[i]->value);
+        
+        for (size_t i = 0; i < 10; ++i)
+            pool.destroy(objects[i]);
+        ASSERT_EQ(0u, pool.size());
+        ASSERT_EQ(0u, PooledObject::instances);
+    }
+    
+    TEST(ObjectPoolTest, reuseStorage) {
+        ObjectPool<PooledObject> pool;
+        
+        PooledObject* first = new (pool.allocate()) PooledObject(1.0);
+        pool.destroy(first);
+        
+        PooledObject* second = new (pool.allocate()) PooledObject(2.0);
+        ASSERT_EQ(first, second);
+        ASSERT_EQ(1u, pool.size());
+        pool.destroy(second);
+    }
+}
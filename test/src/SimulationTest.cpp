@@ -0,0 +1,195 @@
+/*
+ Copyright (C) 2013-2014 Kristian Duske
+ 
+ This file is part of Tippi.
+ 
+ Tippi is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ Tippi is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with Tippi. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "SimpleAutomaton.h"
+#include "Simulation.h"
+
+namespace Tippi {
+    TEST(SimulationTest, emptyGraphs) {
+        LabeledGraph simulator(1);
+        simulator.freeze();
+        LabeledGraph simulatee(1);
+        simulatee.freeze();
+        
+        const Simulation simulation(simulator, simulatee);
+        ASSERT_TRUE(simulation.simulates(0, 0));
+    }
+    
+    TEST(SimulationTest, labeledGraph) {
+        // simulator: 0 -a-> 1, 0 -a-> 2 -b-> 3
+        LabeledGraph simulator(4);
+        simulator.addEdge(0, 0, 1);
+        simulator.addEdge(0, 0, 2);
+        simulator.addEdge(2, 1, 3);
+        simulator.freeze();
+        
+        // simulatee: 0 -a-> 1 -b-> 2 -b-> 3
+        LabeledGraph simulatee(4);
+        simulatee.addEdge(0, 0, 1);
+        simulatee.addEdge(1, 1, 2);
+        simulatee.addEdge(2, 1, 3);
+        simulatee.freeze();
+        
+        const Simulation simulation(simulator, simulatee);
+        ASSERT_TRUE(simulation.simulates(0, 3));
+        ASSERT_TRUE(simulation.simulates(3, 3));
+        ASSERT_TRUE(simulation.simulates(2, 2));
+        ASSERT_FALSE(simulation.simulates(1, 2));
+        ASSERT_FALSE(simulation.simulates(2, 1));
+        ASSERT_FALSE(simulation.simulates(0, 0));
+    }
+    
+    TEST(SimulationTest, nondeterministicSimulator) {
+        SimpleAutomaton simulator;
+        SimpleAutomatonState* i = simulator.createState("i");
+        SimpleAutomatonState* x1 = simulator.createState("x1");
+        SimpleAutomatonState* x2 = simulator.createState("x2");
+        SimpleAutomatonState* y = simulator.createState("y");
+        simulator.setInitialState(i);
+        simulator.connectWithObservableEdge(i, x1, "a");
+        simulator.connectWithObservableEdge(i, x2, "a");
+        simulator.connectWithObservableEdge(x2, y, "b");
+        simulator.connectWithObservableEdge(y, x2, "a");
+        
+        SimpleAutomaton simulatee;
+        SimpleAutomatonState* j = simulatee.createState("j");
+        SimpleAutomatonState* k = simulatee.createState("k");
+        SimpleAutomatonState* l = simulatee.createState("l");
+        simulatee.setInitialState(j);
+        simulatee.connectWithObservableEdge(j, k, "a");
+        simulatee.connectWithObservableEdge(k, l, "b");
+        simulatee.connectWithObservableEdge(l, k, "a");
+        
+        // the simulator must choose x2 as the successor of i
+        ASSERT_TRUE(simulator.simulates(simulatee));
+        ASSERT_TRUE(simulatee.simulates(simulator));
+        
+        simulatee.connectWithObservableEdge(l, l, "b");
+        ASSERT_FALSE(simulator.simulates(simulatee));
+        ASSERT_TRUE(simulatee.simulates(simulator));
+    }
+    
+    TEST(SimulationTest, missingInitialState) {
+        SimpleAutomaton simulator;
+        simulator.createState("i");
+        SimpleAutomaton simulatee;
+        simulatee.setInitialState(simulatee.createState("j"));
+        
+        ASSERT_FALSE(simulator.simulates(simulatee));
+        ASSERT_FALSE(simulatee.simulates(simulator));
+    }
+    
+    TEST(SimulationTest, tauClosure) {
+        // 0 -tau-> 1 -tau-> 0, 1 -tau-> 2, 2 -a-> 3, 3 -tau-> 3
+        const size_t tau = 0;
+        LabeledGraph graph(4);
+        graph.addEdge(0, tau, 1);
+        graph.addEdge(1, tau, 0);
+        graph.addEdge(1, tau, 2);
+        graph.addEdge(2, 1, 3);
+        graph.addEdge(3, tau, 3);
+        graph.freeze();
+        
+        const TauClosure closure(graph, tau);
+        ASSERT_EQ(3u, closure.getComponentCount());
+        ASSERT_EQ(closure.getComponent(0), closure.getComponent(1));
+        ASSERT_NE(closure.getComponent(0), closure.getComponent(2));
+        
+        ASSERT_LT(closure.getComponent(2), closure.getComponent(0));
+        
+        const TauClosure::IndexRange reachable = closure.getClosure(closure.getComponent(0));
+        ASSERT_EQ(2, std::distance(reachable.first, reachable.second));
+        
+        // the tau transitions within a component are dropped from the component graph
+        const LabeledGraph components = closure.buildComponentGraph(graph, tau);
+        ASSERT_EQ(3u, components.getStateCount());
+        LabeledGraph::TransitionRange successors = components.getSuccessors(closure.getComponent(0));
+        ASSERT_EQ(1, std::distance(successors.first, successors.second));
+        ASSERT_EQ(closure.getComponent(2), successors.first->state);
+        successors = components.getSuccessors(closure.getComponent(3));
+        ASSERT_EQ(0, std::distance(successors.first, successors.second));
+    }
+    
+    TEST(SimulationTest, weakSimulationOfTauChain) {
+        // simulator: 0 -tau-> 1 -tau-> ... -tau-> n-1, every state i -a-> i
+        // simulatee: 0 -a-> 0, 0 -tau-> 1 -b-> 1
+        const size_t tau = 0;
+        const size_t n = 1000;
+        LabeledGraph simulator(n + 1);
+        for (size_t i = 0; i + 1 < n; ++i)
+            simulator.addEdge(i, tau, i + 1);
+        for (size_t i = 0; i < n; ++i)
+            simulator.addEdge(i, 1, i);
+        simulator.addEdge(n - 1, 2, n);
+        simulator.freeze();
+        
+        LabeledGraph simulatee(2);
+        simulatee.addEdge(0, 1, 0);
+        simulatee.addEdge(0, tau, 1);
+        simulatee.addEdge(1, 2, 1);
+        simulatee.freeze();
+        
+        const Simulation simulation(simulator, simulatee, tau);
+        ASSERT_FALSE(simulation.simulates(0, 0));
+        ASSERT_FALSE(simulation.simulates(n - 1, 0));
+        ASSERT_FALSE(simulation.simulates(0, 1));
+        ASSERT_FALSE(simulation.simulates(n, 1));
+        
+        // with a b-loop at the end of the chain, every state of the chain simulates both states
+        LabeledGraph loop(n);
+        for (size_t i = 0; i + 1 < n; ++i)
+            loop.addEdge(i, tau, i + 1);
+        for (size_t i = 0; i < n; ++i)
+            loop.addEdge(i, 1, i);
+        loop.addEdge(n - 1, 2, n - 1);
+        loop.freeze();
+        
+        const Simulation loopSimulation(loop, simulatee, tau);
+        ASSERT_TRUE(loopSimulation.simulates(0, 0));
+        ASSERT_TRUE(loopSimulation.simulates(0, 1));
+        ASSERT_TRUE(loopSimulation.simulates(n - 1, 0));
+        ASSERT_TRUE(loopSimulation.simulates(n / 2, 1));
+    }
+    
+    TEST(SimulationTest, weakSimulationWithTauCycle) {
+        SimpleAutomaton simulator;
+        SimpleAutomatonState* i = simulator.createState("i");
+        SimpleAutomatonState* x = simulator.createState("x");
+        SimpleAutomatonState* y = simulator.createState("y");
+        simulator.setInitialState(i);
+        simulator.connectWithUnobservableEdge(i, x);
+        simulator.connectWithUnobservableEdge(x, i);
+        simulator.connectWithObservableEdge(x, y, "a");
+        
+        SimpleAutomaton simulatee;
+        SimpleAutomatonState* j = simulatee.createState("j");
+        SimpleAutomatonState* k = simulatee.createState("k");
+        simulatee.setInitialState(j);
+        simulatee.connectWithObservableEdge(j, k, "a");
+        
+        ASSERT_FALSE(simulator.simulates(simulatee));
+        ASSERT_TRUE(simulator.weaklySimulates(simulatee));
+        ASSERT_TRUE(simulatee.weaklySimulates(simulator));
+        
+        simulatee.connectWithObservableEdge(k, j, "b");
+        ASSERT_FALSE(simulator.weaklySimulates(simulatee));
+    }
+}